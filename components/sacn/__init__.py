@@ -7,6 +7,7 @@ from esphome.components.light.effects import (
     register_monochromatic_effect,
 )
 from esphome.const import CONF_ID, CONF_NAME
+from esphome.core import CORE
 
 DEPENDENCIES = ["network"]
 
@@ -16,6 +17,7 @@ SACNAddressableLightEffect = sacn_ns.class_(
     "SACNAddressableLightEffect", AddressableLightEffect
 )
 SACNComponent = sacn_ns.class_("SACNComponent", cg.Component)
+SACNMetrics = sacn_ns.class_("SACNMetrics", cg.PollingComponent)
 
 SACN_CHANNEL_TYPE = {
     "MONO": sacn_ns.SACN_MONO,
@@ -24,37 +26,155 @@ SACN_CHANNEL_TYPE = {
     "RGBWW": sacn_ns.SACN_RGBWW
 }
 
+SACN_CHANNEL_ORDER = {
+    "RGB": sacn_ns.SACN_ORDER_RGB,
+    "RBG": sacn_ns.SACN_ORDER_RBG,
+    "GRB": sacn_ns.SACN_ORDER_GRB,
+    "GBR": sacn_ns.SACN_ORDER_GBR,
+    "BRG": sacn_ns.SACN_ORDER_BRG,
+    "BGR": sacn_ns.SACN_ORDER_BGR,
+}
+
 SACN_TRANSPORT_MODE = {
     "UNICAST": sacn_ns.SACN_UNICAST,
     "MULTICAST": sacn_ns.SACN_MULTICAST
 }
 
+SACN_PROTOCOL = {
+    "E131": sacn_ns.SACN_E131,
+    "DDP": sacn_ns.SACN_DDP,
+}
+
+SACN_RECEIVE_BACKEND = {
+    "WIFI_UDP": sacn_ns.SACN_BACKEND_WIFI_UDP,
+    "SOCKET": sacn_ns.SACN_BACKEND_SOCKET,
+    "POSIX": sacn_ns.SACN_BACKEND_POSIX,
+}
+
 CONF_SACN_ID = "sacn_id"
 CONF_SACN_UNIVERSE = "universe"
 CONF_SACN_START_CHANNEL = "start_channel"
 CONF_SACN_CHANNEL_TYPE = "channel_type"
 CONF_SACN_TRANSPORT_MODE = "transport_mode"
 CONF_SACN_TIMEOUT = "timeout"
+CONF_SACN_HOLD_TIME = "hold_time"
+CONF_SACN_FADE_TIME = "fade_time"
 CONF_SACN_BLANK_ON_START = "blank_on_start"
+CONF_SACN_UNIVERSE_COUNT = "universe_count"
+CONF_SACN_SYNC_TIMEOUT = "sync_timeout"
+CONF_SACN_HTP_MERGE = "htp_merge"
+CONF_SACN_RECEIVE_BACKEND = "receive_backend"
+CONF_SACN_RECEIVE_TASK = "receive_task"
+CONF_SACN_FRAME_DEADLINE = "frame_deadline"
+CONF_SACN_DIRECT_OUTPUT = "direct_output"
+CONF_SACN_CHANNEL_ORDER = "channel_order"
+CONF_SACN_PIXEL_OFFSET = "pixel_offset"
+CONF_SACN_RESPONSE_CURVE = "response_curve"
+CONF_SACN_RESPONSE_CURVE_ID = "response_curve_id"
+CONF_SACN_FINE_CHANNELS = "fine_channels"
+CONF_SACN_PIXEL_GROUP = "pixel_group"
+CONF_SACN_REVERSE = "reverse"
+CONF_SACN_MATRIX = "matrix"
+CONF_SACN_WIDTH = "width"
+CONF_SACN_SERPENTINE = "serpentine"
+CONF_SACN_SKIP_LEDS = "skip_leds"
+CONF_SACN_INTERPOLATION = "interpolation"
+CONF_SACN_PROTOCOL = "protocol"
 
 CHANNEL_MONO = "MONO"
 CHANNEL_RGB = "RGB"
 CHANNEL_RGBW = "RGBW"
 CHANNEL_RGBWW = "RGBWW"
 
+# Named response curves, mapping a 0.0-1.0 DMX level to a 0.0-1.0 output level
+SACN_RESPONSE_CURVES = {
+    "LINEAR": None,
+    "GAMMA_2_2": lambda x: x**2.2,
+    "SQUARE": lambda x: x * x,
+}
+
+RESPONSE_CURVE_SCHEMA = cv.Any(
+    cv.one_of(*SACN_RESPONSE_CURVES, upper=True),
+    cv.All([cv.percentage], cv.Length(min=2)),
+)
+
+
+def _response_curve_table(curve):
+    """Build the 256-entry 16-bit lookup table for a named curve or a list of points."""
+    if isinstance(curve, str):
+        response = SACN_RESPONSE_CURVES[curve]
+    else:
+        # Custom curve: points evenly spaced over the DMX range, linearly interpolated
+        def response(x):
+            pos = x * (len(curve) - 1)
+            index = min(int(pos), len(curve) - 2)
+            return curve[index] + (curve[index + 1] - curve[index]) * (pos - index)
+
+    return [min(max(round(response(i / 255) * 65535), 0), 65535) for i in range(256)]
+
+
+def _validate_receive_backend(config):
+    if CONF_SACN_RECEIVE_BACKEND not in config:
+        config = config.copy()
+        if CORE.is_host:
+            config[CONF_SACN_RECEIVE_BACKEND] = "POSIX"
+        elif CORE.using_arduino:
+            config[CONF_SACN_RECEIVE_BACKEND] = "WIFI_UDP"
+        else:
+            config[CONF_SACN_RECEIVE_BACKEND] = "SOCKET"
+
+    backend = config[CONF_SACN_RECEIVE_BACKEND]
+    if backend == "WIFI_UDP" and not CORE.using_arduino:
+        raise cv.Invalid("WIFI_UDP receive backend requires the Arduino framework")
+    if backend == "SOCKET" and not (CORE.is_esp32 or CORE.is_host):
+        raise cv.Invalid("SOCKET receive backend is only available on ESP32 and host")
+    if backend == "POSIX" and not CORE.is_host:
+        raise cv.Invalid("POSIX receive backend is only available on host")
+    if config[CONF_SACN_RECEIVE_TASK] and (not CORE.is_esp32 or backend != "SOCKET"):
+        raise cv.Invalid("receive_task is only available on ESP32 with the SOCKET receive backend")
+    return config
+
+
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
             cv.GenerateID(): cv.declare_id(SACNComponent),
+            cv.Optional(CONF_SACN_SYNC_TIMEOUT, default="2500ms"): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_SACN_HTP_MERGE, default=False): cv.boolean,
+            cv.Optional(CONF_SACN_RECEIVE_BACKEND): cv.one_of(*SACN_RECEIVE_BACKEND, upper=True),
+            cv.Optional(CONF_SACN_RECEIVE_TASK, default=False): cv.boolean,
         }
     ),
-    cv.only_with_arduino,
+    _validate_receive_backend,
 )
 
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
 
+    cg.add(var.set_sync_timeout(config[CONF_SACN_SYNC_TIMEOUT]))
+    cg.add(var.set_htp_merge(config[CONF_SACN_HTP_MERGE]))
+    cg.add(var.set_receive_backend(SACN_RECEIVE_BACKEND[config[CONF_SACN_RECEIVE_BACKEND]]))
+    cg.add(var.set_receive_task(config[CONF_SACN_RECEIVE_TASK]))
+
+
+# Settings shared by every sACN effect type
+async def _sacn_effect_common_to_code(config, effect_id):
+    parent = await cg.get_variable(config[CONF_SACN_ID])
+    var = cg.new_Pvariable(effect_id, config[CONF_NAME])
+
+    cg.add(var.set_sacn(parent))
+    cg.add(var.set_universe(config[CONF_SACN_UNIVERSE]))
+    cg.add(var.set_start_channel(config[CONF_SACN_START_CHANNEL]))
+    cg.add(var.set_channel_type(SACN_CHANNEL_TYPE[config[CONF_SACN_CHANNEL_TYPE]]))
+    cg.add(var.set_transport_mode(SACN_TRANSPORT_MODE[config[CONF_SACN_TRANSPORT_MODE]]))
+    cg.add(var.set_timeout(config[CONF_SACN_TIMEOUT]))
+    cg.add(var.set_hold_time(config[CONF_SACN_HOLD_TIME]))
+    cg.add(var.set_fade_time(config[CONF_SACN_FADE_TIME]))
+    cg.add(var.set_blank_on_start(config[CONF_SACN_BLANK_ON_START]))
+    return var
+
+
 @register_rgb_effect(
     "sacn",
     SACNLightEffect,
@@ -66,7 +186,13 @@ async def to_code(config):
         cv.Optional(CONF_SACN_CHANNEL_TYPE, default=CHANNEL_RGB): cv.one_of(CHANNEL_MONO, CHANNEL_RGB, CHANNEL_RGBW, CHANNEL_RGBWW, upper=True),
         cv.Optional(CONF_SACN_TRANSPORT_MODE, default="UNICAST"): cv.one_of(*SACN_TRANSPORT_MODE, upper=True),
         cv.Optional(CONF_SACN_TIMEOUT, default="2500ms"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_SACN_HOLD_TIME, default="0ms"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_SACN_FADE_TIME, default="0ms"): cv.positive_time_period_milliseconds,
         cv.Optional(CONF_SACN_BLANK_ON_START, default=True): cv.boolean,
+        cv.Optional(CONF_SACN_DIRECT_OUTPUT, default=False): cv.boolean,
+        cv.Optional(CONF_SACN_RESPONSE_CURVE, default="LINEAR"): RESPONSE_CURVE_SCHEMA,
+        cv.GenerateID(CONF_SACN_RESPONSE_CURVE_ID): cv.declare_id(cg.uint16),
+        cv.Optional(CONF_SACN_FINE_CHANNELS, default=False): cv.boolean,
     },
 )
 @register_monochromatic_effect(
@@ -80,9 +206,28 @@ async def to_code(config):
         cv.Optional(CONF_SACN_CHANNEL_TYPE, default=CHANNEL_MONO): cv.one_of(CHANNEL_MONO, upper=True),
         cv.Optional(CONF_SACN_TRANSPORT_MODE, default="UNICAST"): cv.one_of(*SACN_TRANSPORT_MODE, upper=True),
         cv.Optional(CONF_SACN_TIMEOUT, default="2500ms"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_SACN_HOLD_TIME, default="0ms"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_SACN_FADE_TIME, default="0ms"): cv.positive_time_period_milliseconds,
         cv.Optional(CONF_SACN_BLANK_ON_START, default=True): cv.boolean,
+        cv.Optional(CONF_SACN_DIRECT_OUTPUT, default=False): cv.boolean,
+        cv.Optional(CONF_SACN_RESPONSE_CURVE, default="LINEAR"): RESPONSE_CURVE_SCHEMA,
+        cv.GenerateID(CONF_SACN_RESPONSE_CURVE_ID): cv.declare_id(cg.uint16),
+        cv.Optional(CONF_SACN_FINE_CHANNELS, default=False): cv.boolean,
     },
 )
+async def sacn_light_effect_to_code(config, effect_id):
+    var = await _sacn_effect_common_to_code(config, effect_id)
+
+    cg.add(var.set_direct_output(config[CONF_SACN_DIRECT_OUTPUT]))
+    curve = config[CONF_SACN_RESPONSE_CURVE]
+    if curve != "LINEAR":
+        table = cg.static_const_array(config[CONF_SACN_RESPONSE_CURVE_ID], _response_curve_table(curve))
+        cg.add(var.set_response_curve(table))
+    cg.add(var.set_fine_channels(config[CONF_SACN_FINE_CHANNELS]))
+
+    return var
+
+
 @register_addressable_effect(
     "addressable_sacn",
     SACNAddressableLightEffect,
@@ -94,19 +239,41 @@ async def to_code(config):
         cv.Optional(CONF_SACN_CHANNEL_TYPE, default="RGB"): cv.one_of(CHANNEL_MONO, CHANNEL_RGB, CHANNEL_RGBW, CHANNEL_RGBWW, upper=True),
         cv.Optional(CONF_SACN_TRANSPORT_MODE, default="UNICAST"): cv.one_of(*SACN_TRANSPORT_MODE, upper=True),
         cv.Optional(CONF_SACN_TIMEOUT, default="2500ms"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_SACN_HOLD_TIME, default="0ms"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_SACN_FADE_TIME, default="0ms"): cv.positive_time_period_milliseconds,
         cv.Optional(CONF_SACN_BLANK_ON_START, default=True): cv.boolean,
+        cv.Optional(CONF_SACN_UNIVERSE_COUNT, default=1): cv.int_range(min=1, max=32),
+        cv.Optional(CONF_SACN_FRAME_DEADLINE, default="25ms"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_SACN_CHANNEL_ORDER, default="RGB"): cv.one_of(*SACN_CHANNEL_ORDER, upper=True),
+        cv.Optional(CONF_SACN_PIXEL_OFFSET, default=0): cv.int_range(min=0, max=65535),
+        cv.Optional(CONF_SACN_PIXEL_GROUP, default=1): cv.int_range(min=1, max=255),
+        cv.Optional(CONF_SACN_REVERSE, default=False): cv.boolean,
+        cv.Optional(CONF_SACN_MATRIX): cv.Schema(
+            {
+                cv.Required(CONF_SACN_WIDTH): cv.int_range(min=1, max=65535),
+                cv.Optional(CONF_SACN_SERPENTINE, default=True): cv.boolean,
+            }
+        ),
+        cv.Optional(CONF_SACN_SKIP_LEDS, default=[]): cv.ensure_list(cv.int_range(min=0, max=65535)),
+        cv.Optional(CONF_SACN_INTERPOLATION, default=False): cv.boolean,
+        cv.Optional(CONF_SACN_PROTOCOL, default="E131"): cv.one_of(*SACN_PROTOCOL, upper=True),
     },
 )
-async def sacn_light_effect_to_code(config, effect_id):
-    parent = await cg.get_variable(config[CONF_SACN_ID])
-    var = cg.new_Pvariable(effect_id, config[CONF_NAME])
+async def sacn_addressable_light_effect_to_code(config, effect_id):
+    var = await _sacn_effect_common_to_code(config, effect_id)
 
-    cg.add(var.set_sacn(parent))
-    cg.add(var.set_universe(config[CONF_SACN_UNIVERSE]))
-    cg.add(var.set_start_channel(config[CONF_SACN_START_CHANNEL]))
-    cg.add(var.set_channel_type(SACN_CHANNEL_TYPE[config[CONF_SACN_CHANNEL_TYPE]]))
-    cg.add(var.set_transport_mode(SACN_TRANSPORT_MODE[config[CONF_SACN_TRANSPORT_MODE]]))
-    cg.add(var.set_timeout(config[CONF_SACN_TIMEOUT]))
-    cg.add(var.set_blank_on_start(config[CONF_SACN_BLANK_ON_START]))
+    cg.add(var.set_universe_count(config[CONF_SACN_UNIVERSE_COUNT]))
+    cg.add(var.set_frame_deadline(config[CONF_SACN_FRAME_DEADLINE]))
+    cg.add(var.set_channel_order(SACN_CHANNEL_ORDER[config[CONF_SACN_CHANNEL_ORDER]]))
+    cg.add(var.set_pixel_offset(config[CONF_SACN_PIXEL_OFFSET]))
+    cg.add(var.set_pixel_group(config[CONF_SACN_PIXEL_GROUP]))
+    cg.add(var.set_reverse(config[CONF_SACN_REVERSE]))
+    if CONF_SACN_MATRIX in config:
+        matrix = config[CONF_SACN_MATRIX]
+        cg.add(var.set_matrix(matrix[CONF_SACN_WIDTH], matrix[CONF_SACN_SERPENTINE]))
+    if config[CONF_SACN_SKIP_LEDS]:
+        cg.add(var.set_skip_leds(sorted(set(config[CONF_SACN_SKIP_LEDS]))))
+    cg.add(var.set_interpolation(config[CONF_SACN_INTERPOLATION]))
+    cg.add(var.set_protocol(SACN_PROTOCOL[config[CONF_SACN_PROTOCOL]]))
 
-    return var
\ No newline at end of file
+    return var
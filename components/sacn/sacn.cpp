@@ -1,27 +1,15 @@
-#ifdef USE_ARDUINO
-
 #include "sacn.h"
 #include "sacn_light_effect_base.h"
 #include "esphome/core/log.h"
+#include "esphome/components/network/util.h"
+
+#include <cinttypes>
 
 namespace esphome {
 namespace sacn {
 
 static const char *const TAG = "sacn";
 
-// E1.31 protocol constants
-const uint8_t SACNComponent::SACN_PACKET_IDENTIFIER[12] = {
-  0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00
-}; // "ASC-E1.17"
-
-const uint8_t SACNComponent::SACN_FRAMING_LAYER_IDENTIFIER[4] = {
-  0x00, 0x00, 0x00, 0x02
-};
-
-const uint8_t SACNComponent::SACN_DMP_LAYER_IDENTIFIER[4] = {
-  0x04, 0x00, 0x00, 0x00
-};
-
 SACNComponent::SACNComponent() : receiving_data_(false), last_packet_time_(0) {}
 SACNComponent::~SACNComponent() {}
 
@@ -30,280 +18,848 @@ void SACNComponent::setup() {
 }
 
 void SACNComponent::loop() {
-  if (!this->udp_) {
+  if (!this->transport_ && !this->ddp_transport_) {
     return;
   }
 
-  std::vector<uint8_t> payload;
   uint32_t now = millis();
+  this->maintain_multicast_(now);
+
+  uint32_t ingest_start = micros();
+  uint32_t packets = this->pipeline_stats_.packets;
+  uint32_t frames = this->pipeline_stats_.frames;
+
+  if (this->queue_) {
+    // Packets received by the receive task
+    uint16_t size;
+    uint32_t from;
+    while (uint8_t *payload = this->queue_->front(&size, &from)) {
+      this->handle_packet_(payload, size, from, now);
+      this->queue_->pop();
+      this->pipeline_stats_.packets++;
+    }
+    this->stats_.malformed += this->queue_malformed_.exchange(0);
+  } else if (this->transport_) {
+    while (uint16_t size = this->transport_->receive(this->packet_, SACN_MAX_PACKET_SIZE)) {
+      this->handle_packet_(this->packet_, size, this->transport_->get_remote_ip(), now);
+      this->pipeline_stats_.packets++;
+    }
+  }
+  uint32_t ddp_convert_us = 0;
+  if (!this->ddp_effects_.empty()) {
+    while (uint16_t size = this->ddp_transport_->receive(this->ddp_packet_.get(), DDPView::MAX_PACKET_SIZE)) {
+      ddp_convert_us += this->handle_ddp_packet_(this->ddp_packet_.get(), size, now);
+      this->pipeline_stats_.packets++;
+    }
+  }
+  // Idle polls are left out, so the timing reflects the cost per packet. DDP packets are converted
+  // as they arrive, that time is counted as convert only.
+  if (this->pipeline_stats_.packets != packets) {
+    this->pipeline_stats_.ingest_us += micros() - ingest_start - ddp_convert_us;
+  }
 
-  while (uint16_t packet_size = this->udp_->parsePacket()) {
-    // Log remote endpoint on first packet
-    if (!this->receiving_data_) {
-      IPAddress remote = this->udp_->remoteIP();
-      ESP_LOGI(TAG, "Started receiving sACN data from %d.%d.%d.%d", remote[0], remote[1], remote[2], remote[3]);
-      this->receiving_data_ = true;
+  for (auto &route : this->universes_) {
+    // Fall back to unsynchronized output when sync packets stop arriving
+    if (route.staged && (now - route.last_sync_ms > this->sync_timeout_)) {
+      ESP_LOGD(TAG, "No sync packet for universe %d on sync address %d, applying frame", route.universe,
+               route.sync_address);
+      this->latch_staged_(&route, now);
     }
-    
-    this->last_packet_time_ = now;
-    payload.resize(packet_size);
 
-    if (!this->udp_->read(&payload[0], payload.size())) {
-      ESP_LOGW(TAG, "Failed to read UDP packet");
-      continue;
+    // Data loss is tracked per universe, the effects hold and fade their output from here on
+    if (route.receiving && now - route.frame.timestamp_ms > SACN_SOURCE_TIMEOUT) {
+      const auto &stats = route.stats;
+      ESP_LOGI(TAG, "Lost universe %d (%" PRIu32 " lost, %" PRIu32 " duplicate, %" PRIu32 " out of order packets)",
+               route.universe, stats.gaps, stats.duplicates, stats.out_of_order);
+      route.receiving = false;
     }
+  }
 
-    // Debug packet structure
-    ESP_LOGV(TAG, "Packet structure analysis (size: %d):", packet_size);
-    ESP_LOGV(TAG, "  Root Layer:");
-    ESP_LOGV(TAG, "    Preamble Size: 0x%02X%02X", payload[0], payload[1]);
-    ESP_LOGV(TAG, "    Post-amble Size: 0x%02X%02X", payload[2], payload[3]);
-    ESP_LOGV(TAG, "    ACN Packet ID: %02X %02X %02X %02X %02X %02X %02X %02X %02X %02X %02X %02X",
-             payload[4], payload[5], payload[6], payload[7], payload[8], payload[9],
-             payload[10], payload[11], payload[12], payload[13], payload[14], payload[15]);
-    
-    ESP_LOGV(TAG, "  Framing Layer:");
-    ESP_LOGV(TAG, "    Source Name: %.64s", &payload[44]);  // Source name is at offset 44
-    ESP_LOGV(TAG, "    Universe: %d", payload[0x7A] | (payload[0x7B] << 8));
-    ESP_LOGV(TAG, "    Priority: %d", payload[0x70]);  // Priority at offset 0x70
-    ESP_LOGV(TAG, "    Sequence Number: %d", payload[0x75]);  // Sequence number at offset 0x75
-    
-    ESP_LOGV(TAG, "  DMP Layer:");
-    ESP_LOGV(TAG, "    Vector: 0x%02X", payload[0x7C]);  // DMP Vector at offset 0x7C
-    ESP_LOGV(TAG, "    Start Code: 0x%02X", payload[0x7D]);  // Start code at offset 0x7D
-    ESP_LOGV(TAG, "    First DMX Values: %02X %02X %02X %02X",
-             payload[0x7E], payload[0x7F], payload[0x80], payload[0x81]);  // DMX data starts at 0x7E
-
-    if (!this->validate_sacn_packet_(&payload[0], payload.size())) {
-      continue;  // Validation function now logs specific issues
-    }
-
-    if (!this->process_(&payload[0], payload.size())) {
-      ESP_LOGW(TAG, "Failed to process sACN packet");
-      continue;
+  if (this->pipeline_stats_.packets != packets || this->pipeline_stats_.frames != frames) {
+    uint32_t busy_us = micros() - ingest_start;
+    this->stats_.busy_loops++;
+    this->stats_.busy_us += busy_us;
+    for (auto &busy_max_us : this->busy_max_us_) {
+      busy_max_us = std::max(busy_max_us, busy_us);
     }
   }
 
-  // Check if we've stopped receiving data (timeout after 5 seconds)
-  if (this->receiving_data_ && (now - this->last_packet_time_ > 5000)) {
-    ESP_LOGI(TAG, "Stopped receiving sACN data");
+  if (this->receiving_data_ && now - this->pipeline_stats_.since_ms >= SACN_STATS_INTERVAL) {
+    this->log_pipeline_stats_(now);
+  }
+
+  // Check if we've stopped receiving data altogether
+  if (this->receiving_data_ && (now - this->last_packet_time_ > SACN_SOURCE_TIMEOUT)) {
+    ESP_LOGI(TAG, "Stopped receiving data");
+    uint32_t overflows = this->queue_overflows_.exchange(0);
+    if (overflows) {
+      ESP_LOGI(TAG, "  Receive queue was full %" PRIu32 " times", overflows);
+    }
     this->receiving_data_ = false;
   }
 }
 
+void SACNComponent::log_pipeline_stats_(uint32_t now) {
+  auto &stats = this->pipeline_stats_;
+  uint32_t elapsed = now - stats.since_ms;
+  if (stats.packets > 0 && elapsed > 0) {
+    ESP_LOGD(TAG,
+             "Pipeline: %" PRIu32 " packets/s at %" PRIu32 " ns/packet ingest, %" PRIu32 " frames/s at %" PRIu32
+             " ns/frame convert",
+             (uint32_t) (stats.packets * 1000ULL / elapsed), (uint32_t) (stats.ingest_us * 1000ULL / stats.packets),
+             (uint32_t) (stats.frames * 1000ULL / elapsed),
+             stats.frames > 0 ? (uint32_t) (stats.convert_us * 1000ULL / stats.frames) : 0);
+  }
+  stats = SACNPipelineStats{};
+  stats.since_ms = now;
+}
+
+void SACNComponent::start_receiving_(uint32_t from, const char *protocol, uint32_t now) {
+  // Log remote endpoint on first packet
+  if (!this->receiving_data_) {
+    const uint8_t *octets = reinterpret_cast<const uint8_t *>(&from);
+    ESP_LOGI(TAG, "Started receiving %s data from %d.%d.%d.%d", protocol, octets[0], octets[1], octets[2], octets[3]);
+    this->receiving_data_ = true;
+    this->pipeline_stats_ = SACNPipelineStats{};
+    this->pipeline_stats_.since_ms = now;
+  }
+
+  this->last_packet_time_ = now;
+
+  this->stats_.packets++;
+}
+
+void SACNComponent::handle_packet_(uint8_t *payload, uint16_t size, uint32_t from, uint32_t now) {
+  this->start_receiving_(from, "sACN", now);
+
+  // Every field read below is covered by this single validation pass
+  E131View packet = E131View::parse(payload, size);
+  if (packet.is_sync()) {
+    this->process_sync_(packet, now);
+    return;
+  }
+  if (!packet.is_data()) {
+    ESP_LOGV(TAG, "Ignoring malformed sACN packet of %d bytes", size);
+    this->stats_.malformed++;
+    return;
+  }
+
+  SACNUniverse *route = this->find_universe_(packet.universe());
+  if (route == nullptr) {
+    ESP_LOGVV(TAG, "Ignoring packet for unbound universe %d", packet.universe());
+    this->stats_.unbound++;
+    return;
+  }
+
+  if (packet.is_preview()) {
+    ESP_LOGVV(TAG, "Ignoring preview data on universe %d", route->universe);
+    this->stats_.preview++;
+    return;
+  }
+  // The levels of a terminating packet are to be ignored
+  if (packet.is_terminated()) {
+    this->terminate_source_(route, packet);
+    return;
+  }
+  if (packet.start_code() == E131View::START_CODE_ADDRESS_PRIORITY) {
+    this->store_address_priorities_(route, packet, now);
+    return;
+  }
+  if (packet.start_code() != E131View::START_CODE_DMX) {
+    ESP_LOGVV(TAG, "Ignoring start code 0x%02X on universe %d", packet.start_code(), route->universe);
+    this->stats_.start_code++;
+    return;
+  }
+  route->stats.record_arrival(micros());
+
+  ESP_LOGVV(TAG, "Packet from '%.64s': universe %d, priority %d, sequence %d, channels %d-%d", packet.source_name(),
+            packet.universe(), packet.priority(), packet.sequence(), packet.first_channel(),
+            packet.first_channel() + packet.dmx_size() - 1);
+
+  if (!this->arbitrate_(route, packet, payload, now)) {
+    return;  // Stale packet, or a higher priority source owns this universe
+  }
+
+  if (this->stage_(route, packet, now)) {
+    return;  // Published when the sync packet arrives
+  }
+
+  route->frame.write(packet);
+  this->publish_frame_(route, now);
+}
+
+uint32_t SACNComponent::handle_ddp_packet_(const uint8_t *payload, uint16_t size, uint32_t now) {
+  this->start_receiving_(this->ddp_transport_->get_remote_ip(), "DDP", now);
+
+  DDPView packet = DDPView::parse(payload, size);
+  if (!packet.is_valid()) {
+    ESP_LOGV(TAG, "Ignoring malformed DDP packet of %d bytes", size);
+    this->stats_.malformed++;
+    return 0;
+  }
+  if (!packet.is_display()) {
+    ESP_LOGVV(TAG, "Ignoring DDP packet for destination %d", packet.destination());
+    this->stats_.unbound++;
+    return 0;
+  }
+
+  ESP_LOGVV(TAG, "DDP packet: sequence %d, offset %" PRIu32 ", %d bytes%s", packet.sequence(), packet.offset(),
+            packet.data_size(), packet.is_push() ? ", push" : "");
+
+  uint32_t convert_start = micros();
+  for (auto *light_effect : this->ddp_effects_) {
+    light_effect->process_ddp_(packet.offset(), packet.data(), packet.data_size(), packet.is_push());
+  }
+  uint32_t convert_us = micros() - convert_start;
+  this->pipeline_stats_.convert_us += convert_us;
+  this->pipeline_stats_.frames++;
+  return convert_us;
+}
+
+bool SACNComponent::add_ddp_effect_(SACNLightEffectBase *light_effect) {
+  if (std::find(this->ddp_effects_.begin(), this->ddp_effects_.end(), light_effect) != this->ddp_effects_.end()) {
+    return true;
+  }
+
+  if (this->ddp_effects_.empty()) {
+    if (!this->ddp_transport_) {
+      this->ddp_transport_ = make_transport(this->receive_backend_);
+      if (!this->ddp_transport_) {
+        ESP_LOGE(TAG, "Receive backend %d is not available on this platform", this->receive_backend_);
+        return false;
+      }
+      this->ddp_packet_.reset(new uint8_t[DDPView::MAX_PACKET_SIZE]);
+    }
+
+    ESP_LOGI(TAG, "Starting UDP listening for DDP on port %d", DDPView::PORT);
+    if (!this->ddp_transport_->begin(DDPView::PORT)) {
+      ESP_LOGE(TAG, "Cannot bind DDP to port %d", DDPView::PORT);
+      return false;
+    }
+  }
+
+  this->ddp_effects_.push_back(light_effect);
+  ESP_LOGD(TAG, "Added DDP effect, total effects: %d", (int) this->ddp_effects_.size());
+  return true;
+}
+
+void SACNComponent::remove_ddp_effect_(SACNLightEffectBase *light_effect) {
+  auto it = std::find(this->ddp_effects_.begin(), this->ddp_effects_.end(), light_effect);
+  if (it == this->ddp_effects_.end()) {
+    return;
+  }
+  this->ddp_effects_.erase(it);
+
+  if (this->ddp_effects_.empty()) {
+    ESP_LOGI(TAG, "Stopping UDP listening for DDP");
+    this->ddp_transport_->stop();
+  }
+}
+
 void SACNComponent::add_effect(SACNLightEffectBase *light_effect) {
+  // DDP effects have their own listener and are not routed by universe
+  if (light_effect->get_protocol() == SACN_DDP) {
+    if (!this->add_ddp_effect_(light_effect)) {
+      mark_failed();
+    }
+    return;
+  }
+
   if (light_effects_.count(light_effect)) {
     return;
   }
 
-  // Only the first effect added needs to start UDP listening
-  if (this->light_effects_.empty()) {
-    if (!this->udp_) {
-      this->udp_ = make_unique<WiFiUDP>();
+  // Only the first effect added needs to start UDP listening. With the receive task
+  // running the socket stays open, as the task may be blocked on it.
+  if (this->light_effects_.empty() && !this->queue_) {
+    if (!this->transport_) {
+      this->transport_ = make_transport(this->receive_backend_);
+      if (!this->transport_) {
+        ESP_LOGE(TAG, "sACN receive backend %d is not available on this platform", this->receive_backend_);
+        mark_failed();
+        return;
+      }
     }
 
     ESP_LOGI(TAG, "Starting UDP listening for sACN on port %d", SACN_PORT);
-    if (!this->udp_->begin(SACN_PORT)) {
+    if (!this->transport_->begin(SACN_PORT)) {
       ESP_LOGE(TAG, "Cannot bind sACN to port %d", SACN_PORT);
       mark_failed();
       return;
     }
+
+#ifdef USE_ESP32
+    if (this->receive_task_) {
+      this->start_receive_task_();
+    }
+#endif
   }
 
   this->light_effects_.insert(light_effect);
-  ESP_LOGD(TAG, "Added sACN effect, total effects: %d", this->light_effects_.size());
+  this->rebuild_universes_();
+
+  if (light_effect->get_transport_mode() == SACN_MULTICAST) {
+    for (uint16_t universe = light_effect->get_first_universe(); universe <= light_effect->get_last_universe();
+         universe++) {
+      this->join_(universe);
+    }
+  }
+
+  ESP_LOGD(TAG, "Added sACN effect, total effects: %d", (int) this->light_effects_.size());
 }
 
 void SACNComponent::remove_effect(SACNLightEffectBase *light_effect) {
+  if (light_effect->get_protocol() == SACN_DDP) {
+    this->remove_ddp_effect_(light_effect);
+    return;
+  }
+
   if (!this->light_effects_.count(light_effect)) {
     return;
   }
 
   this->light_effects_.erase(light_effect);
+  this->rebuild_universes_();
+
+  if (light_effect->get_transport_mode() == SACN_MULTICAST) {
+    for (uint16_t universe = light_effect->get_first_universe(); universe <= light_effect->get_last_universe();
+         universe++) {
+      this->leave_(universe);
+    }
+  }
 
   // If no more effects left, stop UDP listening
-  if (this->light_effects_.empty() && this->udp_) {
+  if (this->light_effects_.empty() && this->transport_ && !this->queue_) {
     ESP_LOGI(TAG, "Stopping UDP listening for sACN");
-    this->udp_->stop();
+    this->transport_->stop();
   }
 }
 
-bool SACNComponent::validate_sacn_packet_(const uint8_t *payload, uint16_t size) {
-  // Minimum sACN packet size (126 bytes for root layer + framing layer + DMP layer + start code)
-  static const uint16_t MIN_PACKET_SIZE = 126;
+void SACNComponent::process_sync_(const E131View &packet, uint32_t now) {
+  uint16_t sync_address = packet.sync_address();
+  if (sync_address == 0) {
+    return;
+  }
 
-  if (size < MIN_PACKET_SIZE) {
-    ESP_LOGD(TAG, "Packet too small: %d bytes (min: %d)", size, MIN_PACKET_SIZE);
-    return false;
+  ESP_LOGV(TAG, "Sync packet for sync address %d", sync_address);
+
+  // Latch every universe waiting on this sync address in one go
+  for (auto &route : this->universes_) {
+    if (route.sync_address != sync_address) {
+      continue;
+    }
+    route.last_sync_ms = now;
+    if (route.staged) {
+      this->latch_staged_(&route, now);
+    }
   }
+}
 
-  // Root Layer validation
-  if (payload[0] != 0x00 || payload[1] != 0x10) {  // Preamble
-    ESP_LOGD(TAG, "Invalid preamble: %02X %02X (expected: 00 10)", payload[0], payload[1]);
+bool SACNComponent::check_sequence_(SACNUniverse *route, SACNSource *source, uint8_t sequence) {
+  // E1.31 section 6.7.2: a packet is out of sequence if it is 0 to 19 behind the last one, modulo 256
+  int8_t diff = static_cast<int8_t>(sequence - source->sequence);
+  if (diff <= 0 && diff > -20) {
+    if (diff == 0) {
+      route->stats.duplicates++;
+    } else {
+      route->stats.out_of_order++;
+    }
+    ESP_LOGVV(TAG, "Dropping packet with sequence %d on universe %d (last %d)", sequence, route->universe,
+              source->sequence);
     return false;
   }
 
-  if (payload[2] != 0x00 || payload[3] != 0x00) {  // Postamble
-    ESP_LOGD(TAG, "Invalid postamble: %02X %02X (expected: 00 00)", payload[2], payload[3]);
-    return false;
+  if (diff > 1) {
+    route->stats.gaps += diff - 1;
   }
+  source->sequence = sequence;
+  return true;
+}
 
-  // Validate ACN packet identifier
-  if (memcmp(payload + 4, SACN_PACKET_IDENTIFIER, sizeof(SACN_PACKET_IDENTIFIER)) != 0) {
-    ESP_LOGD(TAG, "Invalid ACN packet identifier");
-    return false;
+void SACNComponent::terminate_source_(SACNUniverse *route, const E131View &packet) {
+  // Sources send the terminated flag three times, only the first one finds the source still active
+  bool others = false;
+  bool found = false;
+  for (auto &source : route->sources) {
+    if (!source.active) {
+      continue;
+    }
+    if (memcmp(source.cid, packet.cid(), sizeof(source.cid)) == 0) {
+      source.active = false;
+      found = true;
+    } else {
+      others = true;
+    }
+  }
+  if (!found) {
+    return;
   }
+  ESP_LOGD(TAG, "Source '%.64s' terminated universe %d", packet.source_name(), route->universe);
 
-  // Framing Layer validation
-  uint16_t framing_length = (payload[38] << 8) + payload[39] - 0x7000 + 38;
-  if (size < framing_length) {
-    ESP_LOGD(TAG, "Invalid framing layer length: %d", framing_length);
-    return false;
+  // Other sources take over with their next packet. Without any, the universe is lost right away rather than
+  // after the data loss timeout, and the effects move on to their hold and fade on its LEDs.
+  if (others) {
+    return;
+  }
+  route->staged = false;
+  route->receiving = false;
+  for (auto *light_effect : route->effects) {
+    light_effect->terminate_stream_(route->universe);
   }
+}
 
-  // DMP Layer validation
-  uint16_t dmp_length = (payload[115] << 8) + payload[116] - 0x7000 + 115;
-  if (size < dmp_length) {
-    ESP_LOGD(TAG, "Invalid DMP layer length: %d", dmp_length);
-    return false;
+bool SACNComponent::arbitrate_(SACNUniverse *route, const E131View &packet, uint8_t *payload, uint32_t now) {
+  const uint8_t *cid = packet.cid();
+  uint8_t priority = packet.priority();
+  uint8_t sequence = packet.sequence();
+
+  SACNSource *source = nullptr;
+  SACNSource *free_slot = nullptr;
+  for (auto &candidate : route->sources) {
+    if (candidate.active && now - candidate.last_seen_ms > SACN_SOURCE_TIMEOUT) {
+      ESP_LOGD(TAG, "Source with priority %d on universe %d timed out", candidate.priority, route->universe);
+      candidate.active = false;
+    }
+    if (!candidate.active) {
+      if (free_slot == nullptr) {
+        free_slot = &candidate;
+      }
+      continue;
+    }
+    if (memcmp(candidate.cid, cid, sizeof(candidate.cid)) == 0) {
+      source = &candidate;
+    }
   }
 
-  // Validate DMP vector - accept both 0x02 and 0x04
-  uint8_t dmp_vector = payload[117];  // VECTOR_DMP_SET_PROPERTY_ADDR
-  if (dmp_vector != 0x02 && dmp_vector != 0x04) {
-    ESP_LOGD(TAG, "Invalid DMP vector: 0x%02X (expected: 0x02 or 0x04)", dmp_vector);
-    ESP_LOGV(TAG, "Packet bytes around DMP vector: %02X %02X %02X %02X %02X",
-             payload[115], payload[116], payload[117], payload[118], payload[119]);
+  if (source == nullptr) {
+    if (free_slot == nullptr) {
+      ESP_LOGW(TAG, "Ignoring source '%.64s' on universe %d, already tracking %d sources", packet.source_name(),
+               route->universe, SACN_MAX_SOURCES);
+      route->stats.lower_priority++;
+      return false;
+    }
+    source = free_slot;
+    memcpy(source->cid, cid, sizeof(source->cid));
+    source->active = true;
+    source->level_count = 0;
+    source->address_priority = false;
+    source->sequence = sequence;
+    ESP_LOGD(TAG, "New source '%.64s' with priority %d on universe %d", packet.source_name(), priority,
+             route->universe);
+  } else if (!this->check_sequence_(route, source, sequence)) {
     return false;
   }
+  source->priority = priority;
+  source->last_seen_ms = now;
+
+  // Only the highest priority sources are let through, unless priorities are set per address
+  uint8_t top_priority = 0;
+  uint8_t top_sources = 0;
+  bool per_address = false;
+  bool levels_known = true;  // Every other source's levels are stored and current
+  for (auto &candidate : route->sources) {
+    if (!candidate.active) {
+      continue;
+    }
+    per_address |= this->has_address_priorities_(candidate, now);
+    levels_known &= &candidate == source || candidate.level_count > 0;
+    if (candidate.priority > top_priority) {
+      top_priority = candidate.priority;
+      top_sources = 1;
+    } else if (candidate.priority == top_priority) {
+      top_sources++;
+    }
+  }
+
+  // Remember this source's levels for merging, whatever its priority
+  uint16_t first = packet.first_channel() - 1;
+  uint16_t count = packet.dmx_size();
+  uint8_t *levels = payload + packet.dmx_offset();
+  if (per_address || this->htp_merge_) {
+    if (!source->levels) {
+      source->levels.reset(new uint8_t[SACN_MAX_CHANNELS]());
+    }
+    // Channels the source has not sent since (re)appearing are merged as 0, not as an earlier source's levels
+    if (first > source->level_count) {
+      memset(source->levels.get() + source->level_count, 0, first - source->level_count);
+    }
+    memcpy(source->levels.get() + first, levels, count);
+    source->level_count = first == 0 ? count : std::max<uint16_t>(source->level_count, first + count);
+  } else {
+    source->level_count = 0;  // Stale from here on
+  }
+
+  // Until every source has sent levels since per-address priority started, the universe priority decides
+  if (per_address && levels_known) {
+    this->merge_address_priorities_(route, levels, first, count, now);
+    return true;
+  }
 
-  // Validate DMX start code - accept both 0x00 and 0x04
-  uint8_t start_code = payload[125];  // STARTCODE_ADDR
-  if (start_code != 0x00 && start_code != 0x04) {
-    ESP_LOGW(TAG, "Invalid DMX start code: 0x%02X (expected: 0x00 or 0x04)", start_code);
-    ESP_LOGV(TAG, "Packet bytes around start code: %02X %02X %02X %02X %02X",
-             payload[123], payload[124], payload[125], payload[126], payload[127]);
+  if (priority < top_priority) {
+    ESP_LOGVV(TAG, "Dropping packet with priority %d on universe %d (active priority %d)", priority, route->universe,
+              top_priority);
+    route->stats.lower_priority++;
     return false;
   }
 
-  // Log full packet structure at verbose level
-  ESP_LOGV(TAG, "Valid sACN packet structure:");
-  ESP_LOGV(TAG, "  Root Layer:");
-  ESP_LOGV(TAG, "    Preamble: 0x%02X%02X", payload[0], payload[1]);
-  ESP_LOGV(TAG, "    Postamble: 0x%02X%02X", payload[2], payload[3]);
-  ESP_LOGV(TAG, "    ACN Packet ID: %02X %02X %02X %02X...", payload[4], payload[5], payload[6], payload[7]);
-  ESP_LOGV(TAG, "  Framing Layer:");
-  ESP_LOGV(TAG, "    Length: %d", framing_length);
-  ESP_LOGV(TAG, "    Source Name: %.64s", &payload[44]);
-  ESP_LOGV(TAG, "    Priority: %d", payload[108]);
-  ESP_LOGV(TAG, "    Sequence: %d", payload[111]);
-  ESP_LOGV(TAG, "    Universe: %d", (payload[113] << 8) | payload[114]);
-  ESP_LOGV(TAG, "  DMP Layer:");
-  ESP_LOGV(TAG, "    Length: %d", dmp_length);
-  ESP_LOGV(TAG, "    Vector: 0x%02X", dmp_vector);
-  ESP_LOGV(TAG, "    Start Code: 0x%02X", start_code);
-  ESP_LOGV(TAG, "    First DMX Values: %02X %02X %02X %02X",
-           payload[126], payload[127], payload[128], payload[129]);
+  // Merge equal priority sources into the packet in place
+  if (!this->htp_merge_) {
+    return true;
+  }
+
+  if (top_sources < 2) {
+    return true;
+  }
+
+  for (auto &other : route->sources) {
+    if (&other == source || !other.active || other.priority != top_priority || !other.levels) {
+      continue;
+    }
+    uint16_t merge_count = other.level_count > first ? std::min<uint16_t>(count, other.level_count - first) : 0;
+    for (uint16_t i = 0; i < merge_count; i++) {
+      levels[i] = std::max(levels[i], other.levels[first + i]);
+    }
+  }
 
   return true;
 }
 
-uint16_t SACNComponent::get_universe_(const uint8_t *payload) {
-  // Universe number is at offset 113 (0x71)
-  return (payload[113] << 8) | payload[114];
+void SACNComponent::store_address_priorities_(SACNUniverse *route, const E131View &packet, uint32_t now) {
+  // Sources are introduced by their data packets, which arrive far more often
+  SACNSource *source = nullptr;
+  for (auto &candidate : route->sources) {
+    if (candidate.active && memcmp(candidate.cid, packet.cid(), sizeof(candidate.cid)) == 0) {
+      source = &candidate;
+      break;
+    }
+  }
+  if (source == nullptr) {
+    ESP_LOGVV(TAG, "Ignoring per-address priority from unknown source on universe %d", route->universe);
+    return;
+  }
+
+  // Sources number these packets in the same sequence as their data, late ones would replace newer priorities
+  if (!this->check_sequence_(route, source, packet.sequence())) {
+    return;
+  }
+
+  if (!source->address_priorities) {
+    source->address_priorities.reset(new uint8_t[SACN_MAX_CHANNELS]);
+  }
+  if (!this->merge_buffer_) {
+    this->merge_buffer_.reset(new uint8_t[2 * SACN_MAX_CHANNELS]);
+  }
+  if (!this->has_address_priorities_(*source, now)) {
+    ESP_LOGD(TAG, "Source '%.64s' sends per-address priority on universe %d", packet.source_name(),
+             route->universe);
+    memset(source->address_priorities.get(), 0, SACN_MAX_CHANNELS);
+  }
+
+  // Channels past the end of a full packet are not driven by this source
+  uint16_t first = packet.first_channel() - 1;
+  uint16_t count = packet.dmx_size();
+  memcpy(source->address_priorities.get() + first, packet.dmx(), count);
+  if (first == 0) {
+    memset(source->address_priorities.get() + count, 0, SACN_MAX_CHANNELS - count);
+  }
+  source->address_priority = true;
+  source->address_priority_ms = now;
 }
 
-uint16_t SACNComponent::get_start_address_(const uint8_t *payload) {
-  // First property address is at offset 119 (0x77)
-  // DMX addresses are 1-based, so add 1 to the result
-  uint16_t addr = (payload[119] << 8) | payload[120];
-  return addr + 1;
+void SACNComponent::merge_address_priorities_(SACNUniverse *route, uint8_t *levels, uint16_t first, uint16_t count,
+                                              uint32_t now) {
+  uint8_t *priorities = this->merge_buffer_.get();
+  uint8_t *uniform = priorities + SACN_MAX_CHANNELS;
+  memset(levels, 0, count);
+  memset(priorities, 0, count);
+
+  for (auto &source : route->sources) {
+    if (!source.active || !source.levels || source.level_count <= first) {
+      continue;
+    }
+    uint16_t merge_count = std::min<uint16_t>(count, source.level_count - first);
+    const uint8_t *source_priorities;
+    if (this->has_address_priorities_(source, now)) {
+      source_priorities = source.address_priorities.get() + first;
+    } else {
+      // Sources without per-address priority drive every channel at their universe priority; 0 would mean none
+      memset(uniform, std::max<uint8_t>(source.priority, 1), merge_count);
+      source_priorities = uniform;
+    }
+    sacn_merge_priority(levels, priorities, source.levels.get() + first, source_priorities, merge_count);
+  }
 }
 
-uint16_t SACNComponent::get_property_value_count_(const uint8_t *payload) {
-  // Property value count is at offset 123 (0x7B)
-  // Should be 513 for a full universe (512 DMX channels + 1 start code)
-  return (payload[123] << 8) | payload[124];
+bool SACNComponent::stage_(SACNUniverse *route, const E131View &packet, uint32_t now) {
+  // Without synchronization, or without recent sync packets for this address, the frame is applied right away.
+  // A frame still waiting for sync is folded in underneath, so loop() cannot latch it over the newer one.
+  route->sync_address = packet.sync_address();
+  if (route->sync_address == 0 || route->last_sync_ms == 0 || now - route->last_sync_ms > this->sync_timeout_) {
+    if (route->staged) {
+      route->frame = *route->staged_frame;
+      route->staged = false;
+    }
+    return false;
+  }
+
+  // Only the newest frame is kept, an older unsynchronized one is superseded.
+  // Ranges of a universe are written over the frame currently shown.
+  if (!route->staged_frame) {
+    route->staged_frame = make_unique<SACNFrame>();
+  }
+  if (!route->staged) {
+    *route->staged_frame = route->frame;
+  }
+  route->staged_frame->write(packet);
+  route->staged = true;
+  return true;
 }
 
-bool SACNComponent::process_(const uint8_t *payload, uint16_t size) {
-  uint16_t universe = this->get_universe_(payload);
-  uint16_t start_address = this->get_start_address_(payload);
-  uint16_t property_value_count = this->get_property_value_count_(payload);
+void SACNComponent::join_(uint16_t universe) {
+  // Effects sharing a universe share its group membership
+  if (++this->multicast_consumers_[universe] > 1) {
+    return;
+  }
 
-  ESP_LOGV(TAG, "Processing sACN packet - Universe: %d, Start Address: %d, Values: %d",
-           universe, start_address, property_value_count);
+  if (this->set_multicast_membership_(universe, true)) {
+    ESP_LOGD(TAG, "Joined multicast group 239.255.%d.%d for universe %d", universe >> 8, universe & 0xFF, universe);
+  } else {
+    // Normal at boot, when effects start before WiFi is up
+    ESP_LOGW(TAG, "IGMP join for universe %d failed, retrying while the network is up", universe);
+    this->pending_joins_.insert(universe);
+  }
+}
 
-  // DMX data starts at offset 126 (0x7E)
-  const uint16_t DMX_START_OFFSET = 126;  // Fixed offset to DMX data start
-  
-  // Validate property value count (should be at least 1 for start code + data)
-  if (property_value_count < 1) {
-    ESP_LOGW(TAG, "Invalid property value count: %d (must be at least 1)", property_value_count);
-    return false;
+void SACNComponent::leave_(uint16_t universe) {
+  auto consumers = this->multicast_consumers_.find(universe);
+  if (consumers == this->multicast_consumers_.end()) {
+    return;
   }
+  if (--consumers->second > 0) {
+    return;
+  }
+  this->multicast_consumers_.erase(consumers);
 
-  // Validate we have enough data
-  // Only require 1 channel for mono, 3 for RGB, etc.
-  uint16_t min_channels = 1;
-  for (auto *light_effect : this->light_effects_) {
-    if (light_effect->channel_type_ > min_channels) {
-      min_channels = light_effect->channel_type_;
+  // A universe never joined has nothing to leave
+  if (this->pending_joins_.erase(universe) > 0) {
+    return;
+  }
+  if (this->set_multicast_membership_(universe, false)) {
+    ESP_LOGD(TAG, "Left multicast group 239.255.%d.%d for universe %d", universe >> 8, universe & 0xFF, universe);
+  } else {
+    ESP_LOGW(TAG, "IGMP leave for universe %d failed", universe);
+  }
+}
+
+void SACNComponent::maintain_multicast_(uint32_t now) {
+  if (this->multicast_consumers_.empty()) {
+    return;
+  }
+
+  bool connected = network::is_connected();
+  if (connected != this->network_connected_) {
+    this->network_connected_ = connected;
+    if (!connected) {
+      return;
     }
+    // Memberships do not survive the interface going down. Whatever the stack kept is left first, so the
+    // join below does not count it twice.
+    ESP_LOGD(TAG, "Network reconnected, joining %d multicast groups again", (int) this->multicast_consumers_.size());
+    for (auto &consumers : this->multicast_consumers_) {
+      if (this->pending_joins_.insert(consumers.first).second) {
+        this->set_multicast_membership_(consumers.first, false);
+      }
+    }
+    this->last_join_retry_ms_ = now - SACN_JOIN_RETRY_INTERVAL;
+  }
+
+  if (!connected || this->pending_joins_.empty() || now - this->last_join_retry_ms_ < SACN_JOIN_RETRY_INTERVAL) {
+    return;
   }
-  if (size < DMX_START_OFFSET + min_channels) {
-    ESP_LOGW(TAG, "Packet too small for DMX data: %d (need at least %d)", size, DMX_START_OFFSET + min_channels);
+  this->last_join_retry_ms_ = now;
+  for (auto it = this->pending_joins_.begin(); it != this->pending_joins_.end();) {
+    uint16_t universe = *it;
+    if (this->set_multicast_membership_(universe, true)) {
+      ESP_LOGD(TAG, "Joined multicast group 239.255.%d.%d for universe %d", universe >> 8, universe & 0xFF,
+               universe);
+      it = this->pending_joins_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+bool SACNComponent::set_multicast_membership_(uint16_t universe, bool join) {
+  if (!this->transport_) {
     return false;
   }
+  return join ? this->transport_->join_multicast(universe) : this->transport_->leave_multicast(universe);
+}
+
+void SACNComponent::publish_frame_(SACNUniverse *route, uint32_t now) {
+  // Stale packets were already rejected by sequence number, so this frame supersedes any unpulled one
+  route->frame.generation = ++this->frame_generation_;
+  if (route->frame.changed) {
+    route->frame.changed_generation = route->frame.generation;
+    route->frame.changed = false;
+  }
+  route->frame.timestamp_ms = now;
+  route->stats.frames++;
+  route->receiving = true;
+}
+
+void SACNComponent::latch_staged_(SACNUniverse *route, uint32_t now) {
+  route->frame = *route->staged_frame;
+  route->staged = false;
+  this->publish_frame_(route, now);
+}
 
-  // Debug log more packet details
-  ESP_LOGV(TAG, "Packet details:");
-  ESP_LOGV(TAG, "  Size: %d", size);
-  ESP_LOGV(TAG, "  DMX Start Offset: %d", DMX_START_OFFSET);
-  ESP_LOGV(TAG, "  First 10 bytes from DMX start:");
-  for (int i = 0; i < 10 && (DMX_START_OFFSET + i) < size; i++) {
-    ESP_LOGV(TAG, "    [%d]: 0x%02X", i, payload[DMX_START_OFFSET + i]);
+bool SACNComponent::pull_frames(SACNLightEffectBase *light_effect) {
+  bool pulled = false;
+  auto &generations = light_effect->frame_generations_;
+  auto &converted = light_effect->converted_generations_;
+  for (uint16_t i = 0; i < generations.size(); i++) {
+    SACNUniverse *route = this->find_universe_(light_effect->get_first_universe() + i);
+    // Generation 0: nothing received for this universe yet
+    if (route == nullptr || route->frame.generation == 0 || route->frame.generation == generations[i]) {
+      continue;
+    }
+    generations[i] = route->frame.generation;
+    pulled = true;
+    bool changed = converted[i] == 0 || (int32_t) (route->frame.changed_generation - converted[i]) > 0;
+    if (!changed && light_effect->refresh_(route->universe)) {
+      continue;
+    }
+    converted[i] = route->frame.generation;
+
+    uint32_t convert_start = micros();
+    if (!this->process_frame_(light_effect, route->universe, route->frame)) {
+      ESP_LOGW(TAG, "Failed to process sACN frame for universe %d", route->universe);
+    }
+    this->pipeline_stats_.convert_us += micros() - convert_start;
+    this->pipeline_stats_.frames++;
   }
+  return pulled;
+}
 
-  // Debug log the first few bytes of DMX data
-  ESP_LOGV(TAG, "DMX Data [1-3]: %02X %02X %02X", 
-           payload[DMX_START_OFFSET],     // First channel
-           payload[DMX_START_OFFSET + 1], // Second channel
-           payload[DMX_START_OFFSET + 2]); // Third channel
+void SACNComponent::rebuild_universes_() {
+  // Universes still in use keep their sources, sequence numbers, staged frame and stats, so starting or
+  // stopping one effect does not disturb the arbitration of the others
+  for (auto &route : this->universes_) {
+    route.effects.clear();
+  }
 
   for (auto *light_effect : this->light_effects_) {
-    // Calculate the offset for this light effect based on its start channel
-    uint16_t effect_offset = DMX_START_OFFSET + (light_effect->start_channel_ - 1);
-    
-    // Calculate how many channels we need for this effect
-    uint16_t channels_needed = light_effect->channel_type_;
-    
-    // Check if we have enough data for this effect
-    if (effect_offset + channels_needed > size) {
-      ESP_LOGW(TAG, "Not enough data for effect: need %d channels starting at %d, but packet only has %d bytes", 
-               channels_needed, light_effect->start_channel_, size - DMX_START_OFFSET);
-      return false;
+    for (uint16_t universe = light_effect->get_first_universe(); universe <= light_effect->get_last_universe();
+         universe++) {
+      SACNUniverse *route = this->find_universe_(universe);
+      if (route == nullptr) {
+        // Insert keeping the table sorted so lookups can binary search
+        auto pos = std::lower_bound(this->universes_.begin(), this->universes_.end(), universe,
+                                    [](const SACNUniverse &a, uint16_t universe) { return a.universe < universe; });
+        SACNUniverse entry;
+        entry.universe = universe;
+        route = &*this->universes_.insert(pos, std::move(entry));
+      }
+      route->effects.push_back(light_effect);
     }
+  }
 
-    ESP_LOGV(TAG, "Processing effect at channel %d (offset %d)", 
-             light_effect->start_channel_, effect_offset);
+  this->universes_.erase(std::remove_if(this->universes_.begin(), this->universes_.end(),
+                                        [](const SACNUniverse &route) { return route.effects.empty(); }),
+                         this->universes_.end());
 
-    // Process the DMX data starting at the effect's offset
-    uint16_t values_processed = light_effect->process_(payload + effect_offset, 
-                                                     size - effect_offset,  // Remaining size
-                                                     0);  // Used is always 0 as we pass the exact start
-    if (values_processed == 0) {
-      ESP_LOGW(TAG, "Failed to process light effect data");
-      return false;
+  ESP_LOGD(TAG, "Routing %d universe(s)", (int) this->universes_.size());
+}
+
+SACNUniverse *SACNComponent::find_universe_(uint16_t universe) {
+  auto it = std::lower_bound(this->universes_.begin(), this->universes_.end(), universe,
+                             [](const SACNUniverse &a, uint16_t universe) { return a.universe < universe; });
+  if (it == this->universes_.end() || it->universe != universe) {
+    return nullptr;
+  }
+  return &*it;
+}
+
+#ifdef USE_ESP32
+void SACNComponent::start_receive_task_() {
+  if (this->receive_backend_ != SACN_BACKEND_SOCKET) {
+    ESP_LOGE(TAG, "The sACN receive task requires the SOCKET receive backend");
+    return;
+  }
+
+  this->queue_ = make_unique<SACNPacketQueue<SACN_RECEIVE_QUEUE_SIZE, SACN_MAX_PACKET_SIZE>>();
+
+#if portNUM_PROCESSORS > 1
+  // Keep reception off the core running loop()
+  BaseType_t core = xPortGetCoreID() == 0 ? 1 : 0;
+  xTaskCreatePinnedToCore(receive_task_loop_, "sacn_rx", 3072, this, 5, &this->task_handle_, core);
+  ESP_LOGI(TAG, "Started sACN receive task on core %d", core);
+#else
+  xTaskCreate(receive_task_loop_, "sacn_rx", 3072, this, 5, &this->task_handle_);
+  ESP_LOGI(TAG, "Started sACN receive task");
+#endif
+}
+
+void SACNComponent::receive_task_loop_(void *arg) {
+  auto *sacn = static_cast<SACNComponent *>(arg);
+
+  // Nothing in here may log or touch component state other than the queue and its counters
+  for (;;) {
+    if (!sacn->transport_->wait(100)) {
+      continue;
+    }
+
+    uint8_t *slot = sacn->queue_->acquire();
+    if (slot == nullptr) {
+      // loop() is behind, leave the datagrams in the socket buffer for now
+      sacn->queue_overflows_++;
+      vTaskDelay(1);
+      continue;
     }
 
-    ESP_LOGV(TAG, "Processed %d values for effect", values_processed);
+    do {
+      uint16_t size = sacn->transport_->receive(slot, SACN_MAX_PACKET_SIZE);
+      if (size == 0) {
+        break;
+      }
+      // Validated here, so only well-formed data and sync packets take up a slot. The sender is stored with the
+      // packet, the transport replaces it on the next receive().
+      E131View packet = E131View::parse(slot, size);
+      if (packet.is_data() || packet.is_sync()) {
+        sacn->queue_->push(size, sacn->transport_->get_remote_ip());
+      } else {
+        sacn->queue_malformed_++;
+      }
+    } while ((slot = sacn->queue_->acquire()) != nullptr);
+  }
+}
+#endif  // USE_ESP32
+
+bool SACNComponent::process_frame_(SACNLightEffectBase *light_effect, uint16_t universe, const SACNFrame &frame) {
+  ESP_LOGV(TAG, "Processing sACN frame - Universe: %d, Channels: 1-%d", universe, frame.size);
+  if (frame.size >= 3) {
+    ESP_LOGV(TAG, "DMX Data [1-3]: %02X %02X %02X", frame.data[0], frame.data[1], frame.data[2]);
   }
 
+  // Offset of the effect's first channel within the universe
+  uint16_t offset = light_effect->get_channel_offset_(universe);
+  uint16_t channels_needed = light_effect->get_channel_footprint_();
+  if (offset + channels_needed > frame.size) {
+    ESP_LOGW(TAG, "Not enough data for effect: need %d channels starting at %d, but universe %d holds %d",
+             channels_needed, offset + 1, universe, frame.size);
+    return false;
+  }
+
+  uint16_t values_processed = light_effect->process_(universe, frame.data + offset, frame.size - offset, 0);
+  if (values_processed == 0) {
+    ESP_LOGW(TAG, "Failed to process light effect data");
+    return false;
+  }
+
+  ESP_LOGV(TAG, "Processed %d values for effect", values_processed);
   return true;
 }
 
 }  // namespace sacn
 }  // namespace esphome
-
-#endif  // USE_ARDUINO
\ No newline at end of file
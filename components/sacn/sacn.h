@@ -1,23 +1,21 @@
 #pragma once
 
-#ifdef USE_ARDUINO
-
 #include "esphome/core/component.h"
+#include "sacn_ddp.h"
+#include "sacn_e131.h"
+#include "sacn_merge.h"
+#include "sacn_packet_queue.h"
+#include "sacn_transport.h"
 
 #ifdef USE_ESP32
-#include <WiFi.h>
-#endif
-
-#ifdef USE_ESP8266
-#include <ESP8266WiFi.h>
-#include <WiFiUdp.h>
-#endif
-
-#ifdef USE_LIBRETINY
-#include <WiFi.h>
-#include <WiFiUdp.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
 #include <map>
 #include <memory>
 #include <set>
@@ -28,6 +26,122 @@ namespace sacn {
 
 class SACNLightEffectBase;
 
+// Maximum number of sources tracked per universe
+static const uint8_t SACN_MAX_SOURCES = 4;
+
+// A sender (console, media server, ...) transmitting a universe, identified by its CID
+struct SACNSource {
+  uint8_t cid[16];
+  uint8_t priority{0};
+  uint8_t sequence{0};  // Sequence number of the last accepted packet
+  uint32_t last_seen_ms{0};
+  bool active{false};
+  uint16_t level_count{0};
+  std::unique_ptr<uint8_t[]> levels;  // Last DMX levels by channel, only allocated for merging
+
+  // Per-address priority (start code 0xDD), replacing `priority` channel by channel while it keeps arriving
+  bool address_priority{false};
+  uint32_t address_priority_ms{0};
+  std::unique_ptr<uint8_t[]> address_priorities;  // By channel, 0 for channels the source does not drive
+};
+
+// Cumulative counters for a universe, kept while any effect listens to it
+struct SACNUniverseStats {
+  uint32_t packets{0};  // Valid data packets with a null start code
+  uint32_t gaps{0};  // Packets missing between consecutive sequence numbers
+  uint32_t duplicates{0};
+  uint32_t out_of_order{0};  // Late packets that were dropped
+  uint32_t lower_priority{0};  // Dropped for a higher priority source, or past SACN_MAX_SOURCES
+  uint32_t frames{0};  // Frames published to the frame store
+  uint32_t jitter_us{0};  // Smoothed variation between consecutive packet intervals
+  uint32_t last_packet_us{0};
+  uint32_t last_interval_us{0};
+
+  uint32_t dropped() const { return this->duplicates + this->out_of_order + this->lower_priority; }
+
+  // Interarrival jitter as in RFC 3550, measured when loop() picks the packet up
+  void record_arrival(uint32_t now_us) {
+    if (this->last_packet_us != 0) {
+      uint32_t interval = now_us - this->last_packet_us;
+      if (this->last_interval_us != 0) {
+        int32_t deviation = std::abs((int32_t) (interval - this->last_interval_us));
+        this->jitter_us += (deviation - (int32_t) this->jitter_us) / 16;
+      }
+      this->last_interval_us = interval;
+    }
+    this->last_packet_us = now_us;
+    this->packets++;
+  }
+};
+
+// Cumulative counters for packets that never reach a universe, and loop() timing
+struct SACNComponentStats {
+  uint32_t packets{0};  // Every datagram received
+  uint32_t malformed{0};
+  uint32_t unbound{0};  // For universes no effect listens to
+  uint32_t start_code{0};  // Alternate start code packets other than per-address priority, ignored
+  uint32_t preview{0};  // Packets flagged as preview data, ignored
+  uint32_t busy_loops{0};  // loop() iterations that handled at least one packet or frame
+  uint32_t busy_us{0};
+};
+
+// Time spent in each stage of the receive pipeline since the last report
+struct SACNPipelineStats {
+  uint32_t packets{0};
+  uint32_t frames{0};  // Universes pulled by their effects
+  uint32_t ingest_us{0};  // Receive, validation, arbitration and storing the frame
+  uint32_t convert_us{0};  // Effect processing
+  uint32_t since_ms{0};
+};
+
+// Latest DMX data of a universe, owned by the component and pulled by the effects in their apply().
+// Every publish takes a new generation, so each effect processes a frame exactly once.
+struct SACNFrame {
+  uint8_t data[E131View::MAX_SLOTS];
+  uint16_t size{0};  // Channels held, counting from channel 1
+  uint32_t generation{0};  // 0 until the first frame
+  uint32_t timestamp_ms{0};  // When the frame was published
+  // Consoles retransmit unchanged universes at full rate; effects skip converting a frame whose data has not
+  // changed since the generation they last converted
+  uint32_t changed_generation{0};  // Generation at which the data last changed
+  bool changed{false};  // Written data differs from the last published frame
+
+  // A packet starting at channel 1 replaces the frame, a range of a universe is written over it
+  void write(const E131View &packet) {
+    uint16_t count = packet.dmx_size();
+    if (count == 0) {
+      return;
+    }
+    uint16_t first = packet.first_channel() - 1;
+    uint16_t size = first == 0 ? count : std::max<uint16_t>(this->size, first + count);
+    this->changed |= size != this->size || memcmp(this->data + first, packet.dmx(), count) != 0;
+    // Channels below a range that no packet carried yet are off, not whatever the buffer last held
+    if (first > this->size) {
+      memset(this->data + this->size, 0, first - this->size);
+    }
+    memcpy(this->data + first, packet.dmx(), count);
+    this->size = size;
+  }
+};
+
+// Routing entry: the effects bound to a single universe
+struct SACNUniverse {
+  uint16_t universe{0};
+  std::vector<SACNLightEffectBase *> effects;
+
+  // Universe synchronization: frames are held back until the matching sync packet arrives
+  uint16_t sync_address{0};  // Synchronization universe announced by the last data packet
+  uint32_t last_sync_ms{0};  // Time of the last sync packet for sync_address
+  bool staged{false};  // Whether staged_frame holds a frame waiting for sync
+  std::unique_ptr<SACNFrame> staged_frame;  // Allocated once the universe is synchronized
+
+  SACNFrame frame;
+  bool receiving{false};  // A frame was published within SACN_SOURCE_TIMEOUT
+
+  SACNSource sources[SACN_MAX_SOURCES];
+  SACNUniverseStats stats;
+};
+
 class SACNComponent : public esphome::Component {
  public:
   SACNComponent();
@@ -37,31 +151,116 @@ class SACNComponent : public esphome::Component {
   void loop() override;
   float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
 
+  void set_sync_timeout(uint32_t sync_timeout) { this->sync_timeout_ = sync_timeout; }
+  void set_htp_merge(bool htp_merge) { this->htp_merge_ = htp_merge; }
+  void set_receive_backend(SACNReceiveBackend receive_backend) { this->receive_backend_ = receive_backend; }
+  void set_receive_task(bool receive_task) { this->receive_task_ = receive_task; }
+
   void add_effect(SACNLightEffectBase *light_effect);
   void remove_effect(SACNLightEffectBase *light_effect);
 
+  // Hands the effect each of its universes holding a frame it has not processed yet. Called from the
+  // effect's apply(), so conversion runs at the light's rate rather than the packet rate.
+  bool pull_frames(SACNLightEffectBase *light_effect);
+
+  // Counters for the metrics sensors
+  const SACNComponentStats &get_stats() const { return this->stats_; }
+  const std::vector<SACNUniverse> &get_universes() const { return this->universes_; }
+  // The longest busy loop() is a running maximum that each reader resets, so every reader gets its own
+  uint8_t add_busy_max_reader() {
+    this->busy_max_us_.push_back(0);
+    return this->busy_max_us_.size() - 1;
+  }
+  uint32_t take_busy_max_us(uint8_t reader) {
+    uint32_t busy_max_us = this->busy_max_us_[reader];
+    this->busy_max_us_[reader] = 0;
+    return busy_max_us;
+  }
+
  protected:
-  std::unique_ptr<WiFiUDP> udp_;
+  std::unique_ptr<SACNTransport> transport_;
+  SACNReceiveBackend receive_backend_{SACN_BACKEND_WIFI_UDP};
   std::set<SACNLightEffectBase *> light_effects_;
-  
+  std::vector<SACNUniverse> universes_;  // Sorted by universe, updated on add/remove
+  std::map<uint16_t, uint8_t> multicast_consumers_;  // Multicast effects per joined universe
+  // Joined universes without a group membership, as their IGMP join failed or the network went down since.
+  // loop() joins them again while the network is up.
+  std::set<uint16_t> pending_joins_;
+  bool network_connected_{true};  // As of the last loop(), so only a reconnect, not the boot, joins all again
+  uint32_t last_join_retry_ms_{0};
+  static const uint32_t SACN_JOIN_RETRY_INTERVAL = 1000;
+
   // sACN specific members
   static const uint16_t SACN_PORT = 5568;  // Standard sACN port
-  static const uint8_t SACN_PACKET_IDENTIFIER[12];  // Root layer protocol identifier
-  static const uint8_t SACN_FRAMING_LAYER_IDENTIFIER[4];  // Framing layer identifier
-  static const uint8_t SACN_DMP_LAYER_IDENTIFIER[4];  // DMP layer identifier
-  
+  static const uint16_t SACN_MAX_CHANNELS = E131View::MAX_SLOTS;
+  static const uint16_t SACN_MAX_PACKET_SIZE = E131View::HEADER_SIZE + SACN_MAX_CHANNELS;  // 638 bytes
+  static const uint32_t SACN_SOURCE_TIMEOUT = 2500;  // E131_NETWORK_DATA_LOSS_TIMEOUT
+
+  // Receive buffer, packets are parsed and dispatched from here in place
+  uint8_t packet_[SACN_MAX_PACKET_SIZE];
+
+  // Optional receive task: packets are received on the other core and handed to loop() through a queue
+  static const size_t SACN_RECEIVE_QUEUE_SIZE = 8;
+  bool receive_task_{false};
+  std::unique_ptr<SACNPacketQueue<SACN_RECEIVE_QUEUE_SIZE, SACN_MAX_PACKET_SIZE>> queue_;
+  std::atomic<uint32_t> queue_overflows_{0};  // Times the task found the queue full
+  std::atomic<uint32_t> queue_malformed_{0};  // Packets the task dropped, added to stats_.malformed by loop()
+  // DDP listener, open while a DDP effect is active. Its packets are handled straight from loop(),
+  // each one writing its own range of pixels, so they are neither queued nor coalesced.
+  std::unique_ptr<SACNTransport> ddp_transport_;
+  std::vector<SACNLightEffectBase *> ddp_effects_;
+  std::unique_ptr<uint8_t[]> ddp_packet_;  // DDPView::MAX_PACKET_SIZE, allocated with the listener
+
+  // Per-address priority merge: the merged priorities, then a source's universe priority spread over every
+  // channel. Allocated once a source sends per-address priorities.
+  std::unique_ptr<uint8_t[]> merge_buffer_;
+
+#ifdef USE_ESP32
+  TaskHandle_t task_handle_{nullptr};
+  void start_receive_task_();
+  static void receive_task_loop_(void *arg);
+#endif
+
   // State tracking
   bool receiving_data_;  // Whether we're currently receiving sACN data
   uint32_t last_packet_time_;  // Time of last received packet
+  uint32_t sync_timeout_{2500};  // Stop waiting for sync packets after this long without one
+  bool htp_merge_{false};  // Merge equal priority sources highest-takes-precedence
+
+  static const uint32_t SACN_STATS_INTERVAL = 10000;  // Pipeline timings are logged this often while receiving
+  SACNPipelineStats pipeline_stats_;
+  SACNComponentStats stats_;
+  std::vector<uint32_t> busy_max_us_;  // Longest busy loop() since each reader last took it
+  uint32_t frame_generation_{0};  // Last generation published, shared by all universes so it never repeats
+  void log_pipeline_stats_(uint32_t now);
   
-  bool validate_sacn_packet_(const uint8_t *payload, uint16_t size);
-  uint16_t get_universe_(const uint8_t *payload);
-  uint16_t get_start_address_(const uint8_t *payload);
-  uint16_t get_property_value_count_(const uint8_t *payload);
-  bool process_(const uint8_t *payload, uint16_t size);
+  void start_receiving_(uint32_t from, const char *protocol, uint32_t now);
+  void handle_packet_(uint8_t *payload, uint16_t size, uint32_t from, uint32_t now);
+  // Returns the time spent in the effects
+  uint32_t handle_ddp_packet_(const uint8_t *payload, uint16_t size, uint32_t now);
+  bool add_ddp_effect_(SACNLightEffectBase *light_effect);
+  void remove_ddp_effect_(SACNLightEffectBase *light_effect);
+  void process_sync_(const E131View &packet, uint32_t now);
+  bool check_sequence_(SACNUniverse *route, SACNSource *source, uint8_t sequence);
+  bool arbitrate_(SACNUniverse *route, const E131View &packet, uint8_t *payload, uint32_t now);
+  void terminate_source_(SACNUniverse *route, const E131View &packet);
+  void store_address_priorities_(SACNUniverse *route, const E131View &packet, uint32_t now);
+  bool has_address_priorities_(const SACNSource &source, uint32_t now) const {
+    return source.address_priority && now - source.address_priority_ms <= SACN_SOURCE_TIMEOUT;
+  }
+  void merge_address_priorities_(SACNUniverse *route, uint8_t *levels, uint16_t first, uint16_t count, uint32_t now);
+  bool stage_(SACNUniverse *route, const E131View &packet, uint32_t now);
+  void publish_frame_(SACNUniverse *route, uint32_t now);
+  void latch_staged_(SACNUniverse *route, uint32_t now);
+  void join_(uint16_t universe);
+  void leave_(uint16_t universe);
+  // Tracks the network and retries pending joins, called from loop()
+  void maintain_multicast_(uint32_t now);
+  bool set_multicast_membership_(uint16_t universe, bool join);
+  void rebuild_universes_();
+  SACNUniverse *find_universe_(uint16_t universe);
+  bool process_frame_(SACNLightEffectBase *light_effect, uint16_t universe, const SACNFrame &frame);
 };
 
 }  // namespace sacn
 }  // namespace esphome
-
-#endif  // USE_ARDUINO 
\ No newline at end of file
@@ -1,9 +1,9 @@
-#ifdef USE_ARDUINO
-
 #include "sacn.h"
 #include "sacn_addressable_light_effect.h"
 #include "esphome/core/log.h"
 
+#include <cinttypes>
+
 namespace esphome {
 namespace sacn {
 
@@ -16,8 +16,30 @@ const std::string &SACNAddressableLightEffect::get_name() { return AddressableLi
 void SACNAddressableLightEffect::start() {
   ESP_LOGD(TAG, "Starting Addressable sACN effect for '%s'", this->state_->get_name().c_str());
   auto *it = this->get_addressable_();
-  this->last_colors_.resize(it->size(), Color::BLACK);
   this->data_received_ = false;
+  this->frame_dirty_ = false;
+  this->kernels_ = sacn_select_pixel_kernels<light::AddressableLight &>(this->channel_type_, this->channel_order_);
+  this->frame_kernels_ = sacn_select_pixel_kernels<Color *>(this->channel_type_, this->channel_order_);
+
+  // Only listen to as many universes as it takes to cover the strip
+  uint16_t pixel_count = this->has_pixel_map_() ? this->build_pixel_map_(it) : this->get_pixel_count_(it);
+  uint8_t universe_count = 1;
+  while (universe_count < this->universe_count_ && this->get_universe_pixel_offset_(universe_count) < pixel_count) {
+    universe_count++;
+  }
+  if (universe_count < this->universe_count_) {
+    ESP_LOGW(TAG, "'%s' only needs %d of %d universes for %d LEDs", this->get_name().c_str(), universe_count,
+             this->universe_count_, pixel_count);
+    this->universe_count_ = universe_count;
+  }
+  if (this->has_pixel_map_()) {
+    ESP_LOGD(TAG, "'%s' maps %d DMX pixels onto %d LEDs", this->get_name().c_str(), pixel_count,
+             (int) this->pixel_map_.size());
+  }
+  this->frame_complete_mask_ = universe_count >= 32 ? 0xFFFFFFFFUL : (1UL << universe_count) - 1;
+  this->frame_universes_ = 0;
+  this->ddp_hashes_.clear();
+  this->ddp_packet_index_ = 0;
 
   // Blank the LEDs on start if requested and not already done
   if (this->blank_on_start_ && !this->initial_blank_done_) {
@@ -29,6 +51,21 @@ void SACNAddressableLightEffect::start() {
     this->initial_blank_done_ = true;
   }
 
+  // Frame buffers start out as the strip's current colors, so LEDs the mapping never writes keep them
+  if (this->interpolation_) {
+    this->frame_incoming_.resize(it->size());
+    for (int32_t i = 0; i < it->size(); i++) {
+      this->frame_incoming_[i] = (*it)[i].get();
+    }
+    this->frame_from_ = this->frame_incoming_;
+    this->frame_to_ = this->frame_incoming_;
+    this->frame_shown_ = this->frame_incoming_;
+    this->blending_ = false;
+    this->blend_settle_ = false;
+    this->last_frame_ms_ = 0;
+    this->frame_interval_ms_ = 0;
+  }
+
   // Set initial state in Home Assistant - show as white at full brightness
   auto call = this->state_->make_call();
   call.set_color_mode_if_supported(light::ColorMode::RGB);
@@ -48,18 +85,27 @@ void SACNAddressableLightEffect::start() {
 }
 
 void SACNAddressableLightEffect::stop() {
-  this->last_colors_.clear();
   this->data_received_ = false;
+  this->frame_dirty_ = false;
+  this->frame_universes_ = 0;
+
+  this->blending_ = false;
+  std::vector<uint32_t>().swap(this->ddp_hashes_);
+  std::vector<Color>().swap(this->frame_incoming_);
+  std::vector<Color>().swap(this->frame_from_);
+  std::vector<Color>().swap(this->frame_to_);
+  std::vector<Color>().swap(this->frame_shown_);
+  std::vector<Color>().swap(this->fade_from_);
 
   SACNLightEffectBase::stop();
   AddressableLightEffect::stop();
 }
 
 void SACNAddressableLightEffect::apply(light::AddressableLight &it, const Color &current_color) {
-  // If receiving sACN packets times out, reset to Home Assistant color
-  if (this->timeout_check()) {
-    ESP_LOGD(TAG, "sACN stream for '%s->%s' timed out.", this->state_->get_name().c_str(), this->get_name().c_str());
-
+  SACNStreamState previous = this->stream_state_;
+  SACNStreamState state = this->update_stream_state_();
+  if (state == SACN_STREAM_RELEASED && previous != SACN_STREAM_RELEASED && this->data_received_) {
+    // Once every universe is released, reset to Home Assistant color
     auto call = this->state_->turn_on();
     call.set_color_mode_if_supported(this->state_->remote_values.get_color_mode());
     call.set_red_if_supported(this->state_->remote_values.get_red());
@@ -75,109 +121,456 @@ void SACNAddressableLightEffect::apply(light::AddressableLight &it, const Color
     // Effect no longer active
     it.set_effect_active(false);
     this->data_received_ = false;
+    this->frame_dirty_ = false;
+    this->frame_universes_ = 0;
+    // The universes are no longer dark once the Home Assistant color is back, only released
+    for (uint8_t i = 0; i < this->streams_.size(); i++) {
+      this->forget_frame_(i);
+      this->streams_[i].lost = false;
+    }
+    this->blending_ = false;
+    std::vector<Color>().swap(this->fade_from_);
 
     call.perform();
+    return;
+  }
+
+  // Universes with a new frame are written, the strip is shown once the frame is complete
+  this->pull_frames_();
+
+  // A partial frame is shown once past its deadline
+  if (this->frame_dirty_ && millis() - this->frame_start_ms_ >= this->frame_deadline_) {
+    ESP_LOGV(TAG, "Frame deadline passed for '%s' (universes: 0x%08" PRIX32 ")", this->get_name().c_str(),
+             this->frame_universes_);
+    this->frame_universes_ = 0;
+    this->frame_dirty_ = false;
+    this->show_frame_(&it);
   }
 
-  // If we have received data, apply the last known colors
-  if (this->data_received_) {
-    for (size_t i = 0; i < it.size() && i < this->last_colors_.size(); i++) {
-      auto output = it[i];
-      output.set(this->last_colors_[i]);
+  if (this->blending_) {
+    this->render_blend_(it);
+  }
+
+  // A universe that lost its stream fades out on its own LEDs while the others carry on, and ends up dark once
+  // released
+  bool faded = false;
+  for (uint8_t i = 0; i < this->streams_.size(); i++) {
+    const SACNStream &stream = this->streams_[i];
+    if (stream.state == SACN_STREAM_FADING ||
+        (stream.state == SACN_STREAM_RELEASED && stream.lost && stream.fade_level != 0)) {
+      faded |= this->render_fade_(it, i);
     }
+  }
+  if (faded) {
     it.schedule_show();
   }
 }
 
-uint16_t SACNAddressableLightEffect::process_(const uint8_t *payload, uint16_t size, uint16_t used) {
-  auto *it = this->get_addressable_();
+template<typename F> void SACNAddressableLightEffect::for_each_universe_led_(light::AddressableLight &it,
+                                                                         uint8_t universe_index, F f) const {
+  if (this->has_pixel_map_()) {
+    if (universe_index + 1u < this->universe_map_start_.size()) {
+      for (uint16_t i = this->universe_map_start_[universe_index]; i < this->universe_map_start_[universe_index + 1];
+           i++) {
+        f(this->pixel_map_[i].led);
+      }
+    }
+    return;
+  }
+  int32_t first = this->pixel_offset_ + this->get_universe_pixel_offset_(universe_index);
+  int32_t last = this->pixel_offset_ + this->get_universe_pixel_offset_(universe_index + 1);
+  last = std::min<int32_t>(last, it.size());
+  for (int32_t led = first; led < last; led++) {
+    f(led);
+  }
+}
 
-  // Calculate number of pixels we can update based on available data and channel type
-  uint16_t channels_per_pixel;
+void SACNAddressableLightEffect::start_fade_(light::AddressableLight &it, uint8_t universe_index) {
+  if (this->fade_from_.size() != (size_t) it.size()) {
+    this->fade_from_.resize(it.size());
+  }
+  this->for_each_universe_led_(it, universe_index, [&](int32_t led) { this->fade_from_[led] = it[led].get(); });
+
+  // The universe no longer holds up frames of the others, and a resumed stream is converted again even if unchanged
+  this->frame_universes_ &= ~(1UL << universe_index);
+  this->forget_frame_(universe_index);
+}
+
+void SACNAddressableLightEffect::forget_frame_(uint8_t universe_index) {
+  this->converted_generations_[universe_index] = 0;
+  if (this->protocol_ == SACN_DDP) {
+    this->ddp_hashes_.clear();
+    this->ddp_packet_index_ = 0;
+  }
+}
+
+bool SACNAddressableLightEffect::render_fade_(light::AddressableLight &it, uint8_t universe_index) {
+  SACNStream &stream = this->streams_[universe_index];
+  uint16_t level = this->get_fade_level_(universe_index);
+  if (stream.fade_level == NOT_FADING) {
+    this->start_fade_(it, universe_index);
+  } else if (level == stream.fade_level) {
+    return false;
+  }
+  stream.fade_level = level;
+
+  this->for_each_universe_led_(it, universe_index, [&](int32_t led) {
+    const Color &from = this->fade_from_[led];
+    Color color((from.r * level) >> 8, (from.g * level) >> 8, (from.b * level) >> 8, (from.w * level) >> 8);
+    it[led].set(color);
+    // Blends of the other universes keep the faded look, and a resumed stream blends in from it
+    if (this->interpolation_) {
+      this->frame_incoming_[led] = color;
+      this->frame_from_[led] = color;
+      this->frame_to_[led] = color;
+    }
+  });
+  return true;
+}
+
+void SACNAddressableLightEffect::show_frame_(light::AddressableLight *it) {
+  if (!this->interpolation_) {
+    it->schedule_show();
+    return;
+  }
+
+  uint32_t now = millis();
+  this->update_frame_interval_(now);
+
+  // Blend from whatever is on the strip right now, so a late or early frame never jumps
+  if (this->blending_) {
+    this->render_blend_(*it);
+    this->frame_from_.swap(this->frame_shown_);
+  } else {
+    this->frame_from_ = this->frame_to_;
+  }
+  this->frame_to_ = this->frame_incoming_;
+  this->blend_start_ms_ = now;
+  this->blending_ = true;
+  this->blend_settle_ = false;
+}
+
+void SACNAddressableLightEffect::settle_blend_() {
+  if (!this->interpolation_) {
+    return;
+  }
+  // Retransmissions of a static look arrive at the frame rate too, so they keep the interval in step
+  this->update_frame_interval_(millis());
+  this->blend_settle_ = this->blending_;
+}
+
+void SACNAddressableLightEffect::update_frame_interval_(uint32_t now) {
+  if (this->last_frame_ms_ != 0) {
+    // Gaps from lost frames would stretch every following fade, so only on-time frames count
+    uint32_t interval = now - this->last_frame_ms_;
+    if (this->frame_interval_ms_ == 0) {
+      this->frame_interval_ms_ = std::min<uint32_t>(interval, 1000);
+    } else if (interval < this->frame_interval_ms_ * 3 / 2) {
+      this->frame_interval_ms_ = (this->frame_interval_ms_ * 3 + interval) / 4;
+    }
+  }
+  this->last_frame_ms_ = now;
+}
+
+void SACNAddressableLightEffect::render_blend_(light::AddressableLight &it) {
+  uint32_t elapsed = millis() - this->blend_start_ms_;
+  uint32_t interval = std::max<uint32_t>(this->frame_interval_ms_, 1);
+
+  // One frame interval fades to the latest frame. If the next frame is lost, the fade carries on for
+  // another interval to conceal it, then eases back to the latest frame over a third. A settled blend
+  // stops at the latest frame, which an unchanged frame confirmed.
+  int32_t t = 256;
+  if (this->frame_interval_ms_ == 0 || elapsed >= interval * 3 || (this->blend_settle_ && elapsed >= interval)) {
+    this->blending_ = false;
+  } else if (elapsed < interval * 2) {
+    t = elapsed * 256 / interval;
+  } else {
+    t = 512 - (elapsed - interval * 2) * 256 / interval;
+  }
+
+  sacn_blend_pixels(reinterpret_cast<const uint8_t *>(this->frame_from_.data()),
+                    reinterpret_cast<const uint8_t *>(this->frame_to_.data()),
+                    reinterpret_cast<uint8_t *>(this->frame_shown_.data()), this->frame_shown_.size() * sizeof(Color),
+                    t);
+  for (int32_t i = this->pixel_offset_; i < (int32_t) this->frame_shown_.size(); i++) {
+    it[i].set(this->frame_shown_[i]);
+  }
+  it.schedule_show();
+}
+
+uint16_t SACNAddressableLightEffect::get_channels_per_pixel_() const {
   switch (this->channel_type_) {
     case SACN_MONO:
-      channels_per_pixel = 1;
-      break;
+      return 1;
     case SACN_RGB:
-      channels_per_pixel = 3;
-      break;
+      return 3;
     case SACN_RGBW:
-      channels_per_pixel = 4;
-      break;
+      return 4;
     case SACN_RGBWW:
-      channels_per_pixel = 5;
-      break;
+      return 5;
     default:
       return 0;
   }
+}
 
-  uint16_t num_pixels = std::min((size_t)it->size(), (size_t)((size - used) / channels_per_pixel));
-  if (num_pixels < 1) {
+uint16_t SACNAddressableLightEffect::get_universe_pixel_offset_(uint8_t index) const {
+  if (index == 0) {
     return 0;
   }
 
-  ESP_LOGV(TAG, "Applying sACN data for '%s' (size: %d - used: %d - num_pixels: %d - channels_per_pixel: %d)",
-           get_name().c_str(), size, used, num_pixels, channels_per_pixel);
+  uint16_t channels_per_pixel = this->get_channels_per_pixel_();
+  // DDP has no universes, the stream reaches as far as a pixel map entry can address
+  if (this->protocol_ == SACN_DDP) {
+    return 0xFFFF / channels_per_pixel;
+  }
 
-  this->last_sacn_time_ms_ = millis();
-  this->data_received_ = true;
-  it->set_effect_active(true);
-
-  // Process pixels based on channel type
-  for (uint16_t i = 0; i < num_pixels; i++) {
-    uint16_t data_offset = used + (i * channels_per_pixel);
-    auto output = (*it)[i];
-    switch (this->channel_type_) {
-      case SACN_MONO: {
-        float brightness = payload[data_offset] / 255.0f;
-        Color color(brightness * 255, brightness * 255, brightness * 255, 0);
-        output.set(color);
-        this->last_colors_[i] = color;
-        break;
-      }
-      case SACN_RGB: {
-        Color color(payload[data_offset],     // Red
-                   payload[data_offset + 1],  // Green
-                   payload[data_offset + 2],  // Blue
-                   0);                        // White
-        output.set(color);
-        this->last_colors_[i] = color;
-        break;
-      }
-      case SACN_RGBW: {
-        Color color(payload[data_offset],     // Red
-                   payload[data_offset + 1],  // Green
-                   payload[data_offset + 2],  // Blue
-                   payload[data_offset + 3]); // White
-        output.set(color);
-        this->last_colors_[i] = color;
-        break;
+  // Pixels never straddle universes: the first universe starts at start_channel, the rest at channel 1
+  uint16_t first_universe_pixels = (512 - (this->start_channel_ - 1)) / channels_per_pixel;
+  return first_universe_pixels + (index - 1) * (512 / channels_per_pixel);
+}
+
+uint16_t SACNAddressableLightEffect::build_pixel_map_(light::AddressableLight *it) {
+  this->pixel_map_.clear();
+  this->universe_map_start_.clear();
+
+  // LEDs left to drive, in the order consecutive DMX pixels (or matrix cells) run along them
+  std::vector<uint16_t> chain;
+  for (int32_t led = this->pixel_offset_; led < it->size(); led++) {
+    if (!std::binary_search(this->skip_leds_.begin(), this->skip_leds_.end(), led)) {
+      chain.push_back(led);
+    }
+  }
+  if (this->reverse_) {
+    std::reverse(chain.begin(), chain.end());
+  }
+
+  uint16_t group = std::max<uint8_t>(this->pixel_group_, 1);
+  uint16_t cells = (chain.size() + group - 1) / group;
+  uint16_t width = this->matrix_width_;
+  uint16_t pixel_count = cells;
+  if (width > 0) {
+    // DMX data runs row by row; round up to whole rows
+    pixel_count = (cells + width - 1) / width * width;
+  }
+
+  uint16_t channels_per_pixel = this->get_channels_per_pixel_();
+  for (uint8_t index = 0; index < this->universe_count_; index++) {
+    this->universe_map_start_.push_back(this->pixel_map_.size());
+    uint16_t first = this->get_universe_pixel_offset_(index);
+    uint16_t last = std::min<uint16_t>(this->get_universe_pixel_offset_(index + 1), pixel_count);
+    for (uint16_t pixel = first; pixel < last; pixel++) {
+      uint16_t cell = pixel;
+      if (width > 0 && this->serpentine_ && (pixel / width) % 2 == 1) {
+        cell = (pixel / width) * width + (width - 1 - pixel % width);
       }
-      case SACN_RGBWW: {
-        // Set RGB using Color, but do NOT set white (leave at 0)
-        Color color(payload[data_offset],     // Red
-                   payload[data_offset + 1],  // Green
-                   payload[data_offset + 2],  // Blue
-                   0);                        // White (not used)
-        output.set(color);
-        // ESPColorView does not support set_cold_white/set_warm_white.
-        // As a fallback, set the white channel to cold or warm white, whichever is higher.
-        // This is the best possible mapping for addressable strips with only a single white channel.
-        float cold_white = payload[data_offset + 3] / 255.0f;
-        float warm_white = payload[data_offset + 4] / 255.0f;
-        float white = std::max(cold_white, warm_white);
-        output.set_white(white * 255);
-        this->last_colors_[i] = color;
-        break;
+      for (uint16_t i = 0; i < group && cell * group + i < chain.size(); i++) {
+        this->pixel_map_.push_back({chain[cell * group + i], (uint16_t) ((pixel - first) * channels_per_pixel)});
       }
     }
   }
+  this->universe_map_start_.push_back(this->pixel_map_.size());
+  this->pixel_map_.shrink_to_fit();
+
+  return pixel_count;
+}
+
+uint16_t SACNAddressableLightEffect::process_(uint16_t universe, const uint8_t *payload, uint16_t size,
+                                              uint16_t used) {
+  auto *it = this->get_addressable_();
+
+  // Calculate number of pixels we can update based on available data and channel type
+  uint16_t channels_per_pixel = this->get_channels_per_pixel_();
+  if (channels_per_pixel == 0 || this->kernels_.convert == nullptr) {
+    return 0;
+  }
+
+  uint8_t universe_index = universe - this->universe_;
+  uint16_t first_pixel = this->get_universe_pixel_offset_(universe_index);
+  if (this->has_pixel_map_()) {
+    uint16_t mapped = this->process_mapped_(universe_index, payload + used, size - used, 0);
+    if (mapped > 0) {
+      this->mark_universe_(universe_index, true);
+    }
+    return mapped;
+  }
+
+  uint16_t pixel_count = this->get_pixel_count_(it);
+  if (first_pixel >= pixel_count) {
+    return 0;
+  }
+
+  uint16_t num_pixels = std::min((size_t)(pixel_count - first_pixel), (size_t)((size - used) / channels_per_pixel));
+  if (num_pixels < 1) {
+    return 0;
+  }
+
+  ESP_LOGV(TAG,
+           "Applying sACN data for '%s' (universe: %d - size: %d - used: %d - first_pixel: %d - num_pixels: %d - "
+           "channels_per_pixel: %d)",
+           this->get_name().c_str(), universe, size, used, first_pixel, num_pixels, channels_per_pixel);
+
+  this->write_pixels_(payload + used, first_pixel, num_pixels);
+  this->mark_universe_(universe_index, true);
 
-  it->schedule_show();
   return num_pixels * channels_per_pixel;
 }
 
+bool SACNAddressableLightEffect::refresh_(uint16_t universe) {
+  // The strip still shows this universe's data, the frame only completes
+  this->mark_universe_(universe - this->universe_, false);
+  return true;
+}
+
+uint16_t SACNAddressableLightEffect::process_ddp_(uint32_t offset, const uint8_t *data, uint16_t size, bool push) {
+  auto *it = this->get_addressable_();
+
+  uint16_t channels_per_pixel = this->get_channels_per_pixel_();
+  if (channels_per_pixel == 0 || this->kernels_.convert == nullptr) {
+    return 0;
+  }
+
+  // Senders split frames on pixel boundaries; a pixel cut in two is dropped
+  uint16_t skip = (channels_per_pixel - offset % channels_per_pixel) % channels_per_pixel;
+  uint16_t written = 0;
+  bool changed = false;
+  if (size > skip) {
+    uint32_t first_pixel = (offset + skip) / channels_per_pixel;
+    data += skip;
+    size -= skip;
+
+    changed = this->ddp_changed_(offset, data, size);
+    if (!changed) {
+      this->mark_received_(0);
+    } else if (this->has_pixel_map_()) {
+      if (first_pixel < this->get_universe_pixel_offset_(1)) {
+        written = this->process_mapped_(0, data, size, first_pixel * channels_per_pixel);
+      }
+    } else if (first_pixel < this->get_pixel_count_(it)) {
+      uint16_t num_pixels = std::min<uint32_t>(this->get_pixel_count_(it) - first_pixel, size / channels_per_pixel);
+      this->write_pixels_(data, first_pixel, num_pixels);
+      written = num_pixels * channels_per_pixel;
+    }
+  }
+
+  ESP_LOGV(TAG, "Applying DDP data for '%s' (offset: %" PRIu32 " - size: %d - written: %d%s%s)",
+           this->get_name().c_str(), offset, size, written, changed ? "" : " - unchanged", push ? " - push" : "");
+
+  if (written > 0) {
+    this->mark_written_(0);
+  }
+
+  // The push flag latches the frame, showing every packet received since the previous push at once
+  if (push) {
+    this->ddp_packet_index_ = 0;
+    if (this->frame_dirty_) {
+      this->frame_dirty_ = false;
+      this->show_frame_(it);
+    } else {
+      this->settle_blend_();
+    }
+  }
+
+  return changed ? written : size;
+}
+
+void SACNAddressableLightEffect::write_pixels_(const uint8_t *data, uint16_t first_pixel, uint16_t num_pixels) {
+  if (this->interpolation_) {
+    this->frame_kernels_.convert(data, num_pixels, this->frame_incoming_.data(), this->pixel_offset_ + first_pixel);
+  } else {
+    this->kernels_.convert(data, num_pixels, *this->get_addressable_(), this->pixel_offset_ + first_pixel);
+  }
+}
+
+uint16_t SACNAddressableLightEffect::process_mapped_(uint8_t universe_index, const uint8_t *data, uint16_t size,
+                                                     uint16_t offset) {
+  if (universe_index + 1 >= this->universe_map_start_.size()) {
+    return 0;
+  }
+
+  // Entries are in DMX order, so the ones covered by this packet are a contiguous run of the universe's range
+  auto begin = this->pixel_map_.begin() + this->universe_map_start_[universe_index];
+  auto end = this->pixel_map_.begin() + this->universe_map_start_[universe_index + 1];
+  uint16_t channels_per_pixel = this->get_channels_per_pixel_();
+  uint32_t available = size / channels_per_pixel * channels_per_pixel;
+  auto before = [](const SACNPixelMapEntry &entry, uint32_t offset) { return entry.offset < offset; };
+  begin = std::lower_bound(begin, end, offset, before);
+  end = std::lower_bound(begin, end, offset + available, before);
+  if (begin == end) {
+    return 0;
+  }
+
+  if (this->interpolation_) {
+    this->frame_kernels_.gather(data, offset, &*begin, end - begin, this->frame_incoming_.data());
+  } else {
+    this->kernels_.gather(data, offset, &*begin, end - begin, *this->get_addressable_());
+  }
+
+  return (end - 1)->offset + channels_per_pixel - offset;
+}
+
+bool SACNAddressableLightEffect::ddp_changed_(uint32_t offset, const uint8_t *data, uint16_t size) {
+  // Senders split every frame into the same packets, so a packet is compared with the one at the same position.
+  // FNV-1a over the offset and data.
+  uint32_t hash = 2166136261UL;
+  for (uint8_t i = 0; i < 4; i++) {
+    hash = (hash ^ ((offset >> (i * 8)) & 0xFF)) * 16777619UL;
+  }
+  for (uint16_t i = 0; i < size; i++) {
+    hash = (hash ^ data[i]) * 16777619UL;
+  }
+
+  uint8_t index = this->ddp_packet_index_;
+  if (index >= DDP_MAX_HASHES) {
+    return true;
+  }
+  this->ddp_packet_index_++;
+  if (index < this->ddp_hashes_.size()) {
+    bool changed = this->ddp_hashes_[index] != hash;
+    this->ddp_hashes_[index] = hash;
+    return changed;
+  }
+  this->ddp_hashes_.resize(index + 1, 0);
+  this->ddp_hashes_[index] = hash;
+  return true;
+}
+
+void SACNAddressableLightEffect::mark_written_(uint8_t universe_index) {
+  this->mark_received_(universe_index);
+  this->data_received_ = true;
+  this->get_addressable_()->set_effect_active(true);
+
+  if (!this->frame_dirty_) {
+    this->frame_start_ms_ = this->streams_[universe_index].last_ms;
+    this->frame_dirty_ = true;
+  }
+}
+
+void SACNAddressableLightEffect::mark_universe_(uint8_t universe_index, bool changed) {
+  if (changed) {
+    this->mark_written_(universe_index);
+  } else {
+    this->mark_received_(universe_index);
+  }
+
+  // Show once every universe of the frame has arrived, unless all of them were retransmissions. Universes that
+  // lost their stream are not waited for.
+  uint32_t expected = this->frame_complete_mask_;
+  for (uint8_t i = 0; i < this->streams_.size(); i++) {
+    if (this->streams_[i].lost) {
+      expected &= ~(1UL << i);
+    }
+  }
+  this->frame_universes_ |= 1UL << universe_index;
+  if ((this->frame_universes_ & expected) == expected) {
+    this->frame_universes_ = 0;
+    if (this->frame_dirty_) {
+      this->frame_dirty_ = false;
+      this->show_frame_(this->get_addressable_());
+    } else {
+      this->settle_blend_();
+    }
+  }
+}
+
 }  // namespace sacn
 }  // namespace esphome
-
-#endif  // USE_ARDUINO
\ No newline at end of file
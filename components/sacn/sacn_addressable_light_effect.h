@@ -1,10 +1,11 @@
 #pragma once
 
-#ifdef USE_ARDUINO
-
 #include "esphome/core/component.h"
 #include "esphome/components/light/addressable_light_effect.h"
 #include "sacn_light_effect_base.h"
+#include "sacn_pixel_kernels.h"
+
+#include <vector>
 
 namespace esphome {
 namespace sacn {
@@ -21,18 +22,113 @@ class SACNAddressableLightEffect : public SACNLightEffectBase, public light::Add
   void apply(light::AddressableLight &it, const Color &current_color) override;
 
   void set_blank_on_start(bool blank) { this->blank_on_start_ = blank; }
+  void set_frame_deadline(uint32_t frame_deadline) { this->frame_deadline_ = frame_deadline; }
+  void set_channel_order(SACNChannelOrder channel_order) { this->channel_order_ = channel_order; }
+  void set_pixel_offset(uint16_t pixel_offset) { this->pixel_offset_ = pixel_offset; }
+  void set_pixel_group(uint8_t pixel_group) { this->pixel_group_ = pixel_group; }
+  void set_reverse(bool reverse) { this->reverse_ = reverse; }
+  void set_matrix(uint16_t width, bool serpentine) {
+    this->matrix_width_ = width;
+    this->serpentine_ = serpentine;
+  }
+  void set_skip_leds(const std::vector<uint16_t> &skip_leds) { this->skip_leds_ = skip_leds; }
+  void set_interpolation(bool interpolation) { this->interpolation_ = interpolation; }
 
  protected:
-  uint16_t process_(const uint8_t *payload, uint16_t size, uint16_t used) override;
+  uint16_t process_(uint16_t universe, const uint8_t *payload, uint16_t size, uint16_t used) override;
+  bool refresh_(uint16_t universe) override;
+  uint16_t process_ddp_(uint32_t offset, const uint8_t *data, uint16_t size, bool push) override;
+  // Converts consecutive DMX pixels onto consecutive LEDs, or into frame_incoming_ with interpolation
+  void write_pixels_(const uint8_t *data, uint16_t first_pixel, uint16_t num_pixels);
+  // Writes one universe's pixels through pixel_map_, where data starts `offset` bytes into the universe
+  uint16_t process_mapped_(uint8_t universe_index, const uint8_t *data, uint16_t size, uint16_t offset);
+  // Compares a DDP packet with the one at the same position in the previous frame
+  bool ddp_changed_(uint32_t offset, const uint8_t *data, uint16_t size);
+  // Makes the next frame of a universe count as changed, once the strip no longer shows what was converted
+  void forget_frame_(uint8_t universe_index);
+  // Records that pixels of a universe of the current frame were written, starting the frame deadline
+  void mark_written_(uint8_t universe_index);
+  // Records that a universe of the current frame arrived and shows the frame once complete, if anything changed
+  void mark_universe_(uint8_t universe_index, bool changed);
+  // Shows the frame, or starts blending towards it with interpolation
+  void show_frame_(light::AddressableLight *it);
+  // A complete frame arrived unchanged: the blend ends at the latest frame instead of running past it
+  void settle_blend_();
+  // Updates the smoothed frame interval with a complete frame arriving now
+  void update_frame_interval_(uint32_t now);
+  // Writes the blend between frame_from_ and frame_to_ for the current time to the strip
+  void render_blend_(light::AddressableLight &it);
+  // Captures a universe's LEDs as its last look, once its stream starts fading
+  void start_fade_(light::AddressableLight &it, uint8_t universe_index);
+  // Writes a universe's last look scaled down to its current fade level. Returns false if the level is unchanged.
+  bool render_fade_(light::AddressableLight &it, uint8_t universe_index);
+  // Calls f(led) for every LED the n-th universe drives
+  template<typename F> void for_each_universe_led_(light::AddressableLight &it, uint8_t universe_index, F f) const;
+
+  uint16_t get_channels_per_pixel_() const;
+  // Index of the first pixel carried by the n-th universe of this effect. A DDP stream counts as one universe.
+  uint16_t get_universe_pixel_offset_(uint8_t index) const;
+
+  // Number of LEDs driven by this effect, after pixel_offset_
+  uint16_t get_pixel_count_(light::AddressableLight *it) const {
+    return it->size() > this->pixel_offset_ ? it->size() - this->pixel_offset_ : 0;
+  }
+
+  bool has_pixel_map_() const {
+    return this->pixel_group_ > 1 || this->reverse_ || this->matrix_width_ > 0 || !this->skip_leds_.empty();
+  }
+  // Fills pixel_map_ for the current strip and returns the number of DMX pixels it consumes
+  uint16_t build_pixel_map_(light::AddressableLight *it);
+
+  SACNChannelOrder channel_order_{SACN_ORDER_RGB};
+  uint16_t pixel_offset_{0};  // First LED driven by this effect
+  // Converters for channel_type_ and channel_order_, picked in start()
+  SACNPixelKernels<light::AddressableLight &> kernels_;
+  SACNPixelKernels<Color *> frame_kernels_;
+
+  // Pixel mapping, resolved into pixel_map_ by start()
+  uint8_t pixel_group_{1};  // LEDs driven by each DMX pixel
+  bool reverse_{false};
+  uint16_t matrix_width_{0};  // 0 for a plain strip
+  bool serpentine_{false};  // Every other matrix row runs backwards
+  std::vector<uint16_t> skip_leds_;  // Sorted; LEDs the mapping flows around
+
+  std::vector<SACNPixelMapEntry> pixel_map_;  // Entries of each universe in DMX order, empty when unmapped
+  std::vector<uint16_t> universe_map_start_;  // Index of each universe's first entry, plus the end
 
-  // Store the last received values for each LED
-  std::vector<Color> last_colors_;
   bool data_received_{false};
   bool blank_on_start_{false};
   bool initial_blank_done_{false};
+
+  // Frame assembly across universes; the strip is shown once all universes arrived or the deadline passed
+  uint32_t frame_deadline_{25};
+  uint32_t frame_start_ms_{0};
+  uint32_t frame_universes_{0};  // Bit n set once universe_ + n arrived for the current frame
+  uint32_t frame_complete_mask_{1};
+  bool frame_dirty_{false};  // Pixels were written since the last show
+
+  // Change detection for DDP, which bypasses the frame store: a hash of each packet of the last frame, by its
+  // position in the frame
+  static const uint8_t DDP_MAX_HASHES = 64;
+  std::vector<uint32_t> ddp_hashes_;
+  uint8_t ddp_packet_index_{0};  // Position of the next packet in the current frame
+
+  // Interpolation: process_() fills frame_incoming_, complete frames are latched into frame_to_ and
+  // apply() blends from what was on the strip at that moment towards it. All buffers are indexed by LED.
+  bool interpolation_{false};
+  bool blending_{false};
+  bool blend_settle_{false};  // Set by settle_blend_() until the next frame
+  uint32_t blend_start_ms_{0};
+  uint32_t last_frame_ms_{0};
+  uint32_t frame_interval_ms_{0};  // Smoothed time between frames, 0 until two frames arrived
+  std::vector<Color> frame_incoming_;
+  std::vector<Color> frame_from_;
+  std::vector<Color> frame_to_;
+  std::vector<Color> frame_shown_;
+
+  // Loss of signal: each fading universe's LEDs as they were when its stream started fading, indexed by LED
+  std::vector<Color> fade_from_;
 };
 
 }  // namespace sacn
 }  // namespace esphome
-
-#endif  // USE_ARDUINO
\ No newline at end of file
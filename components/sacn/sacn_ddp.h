@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+
+namespace esphome {
+namespace sacn {
+
+// Read-only view of a received DDP (Distributed Display Protocol) packet. parse() validates the header,
+// after which data() stays within the received bytes.
+class DDPView {
+ public:
+  static const uint16_t PORT = 4048;
+  static const uint16_t HEADER_SIZE = 10;
+  static const uint16_t TIMECODE_SIZE = 4;  // Follows the header when FLAG_TIMECODE is set
+  static const uint16_t MAX_DATA_SIZE = 1440;
+  static const uint16_t MAX_PACKET_SIZE = HEADER_SIZE + TIMECODE_SIZE + MAX_DATA_SIZE;
+
+  static const uint8_t VERSION_MASK = 0xC0;
+  static const uint8_t VERSION_1 = 0x40;
+  static const uint8_t FLAG_TIMECODE = 0x10;
+  static const uint8_t FLAG_STORAGE = 0x08;
+  static const uint8_t FLAG_REPLY = 0x04;
+  static const uint8_t FLAG_QUERY = 0x02;
+  static const uint8_t FLAG_PUSH = 0x01;
+
+  static const uint8_t ID_DISPLAY = 1;  // Default output device
+  static const uint8_t ID_ALL = 255;
+
+  constexpr DDPView() = default;
+
+  static constexpr DDPView parse(const uint8_t *data, uint16_t size) {
+    if (size < HEADER_SIZE || (data[0] & VERSION_MASK) != VERSION_1) {
+      return DDPView();
+    }
+    // Queries, replies and storage access are for configuration, not display data
+    if (data[0] & (FLAG_STORAGE | FLAG_REPLY | FLAG_QUERY)) {
+      return DDPView();
+    }
+    uint16_t header_size = (data[0] & FLAG_TIMECODE) ? HEADER_SIZE + TIMECODE_SIZE : HEADER_SIZE;
+    uint16_t length = (data[8] << 8) | data[9];
+    if (size < header_size || length > MAX_DATA_SIZE || length > size - header_size) {
+      return DDPView();
+    }
+    return DDPView(data, header_size, length);
+  }
+
+  constexpr bool is_valid() const { return this->data_ != nullptr; }
+
+  // Push: the packet completes a frame, everything received since the previous push is shown
+  constexpr bool is_push() const { return this->data_[0] & FLAG_PUSH; }
+  constexpr uint8_t sequence() const { return this->data_[1] & 0x0F; }  // 1-15, 0 when unused
+  constexpr uint8_t data_type() const { return this->data_[2]; }
+  constexpr uint8_t destination() const { return this->data_[3]; }
+  constexpr bool is_display() const {
+    return this->destination() == ID_DISPLAY || this->destination() == ID_ALL;
+  }
+
+  // Byte offset of data()[0] within the device's channel data
+  constexpr uint32_t offset() const {
+    return ((uint32_t) this->data_[4] << 24) | ((uint32_t) this->data_[5] << 16) | (this->data_[6] << 8) |
+           this->data_[7];
+  }
+  constexpr const uint8_t *data() const { return this->data_ + this->header_size_; }
+  constexpr uint16_t data_size() const { return this->length_; }
+
+ protected:
+  constexpr DDPView(const uint8_t *data, uint16_t header_size, uint16_t length)
+      : data_(data), header_size_(header_size), length_(length) {}
+
+  const uint8_t *data_{nullptr};
+  uint16_t header_size_{0};
+  uint16_t length_{0};
+};
+
+}  // namespace sacn
+}  // namespace esphome
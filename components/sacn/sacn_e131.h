@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace esphome {
+namespace sacn {
+
+// Expected value and significant bits of every fixed header byte of an E1.31 packet
+template<uint16_t SIZE> struct E131HeaderTemplate {
+  uint8_t value[SIZE];
+  uint8_t mask[SIZE];
+
+  constexpr void set(uint16_t offset, uint8_t value, uint8_t mask = 0xFF) {
+    this->value[offset] = value;
+    this->mask[offset] = mask;
+  }
+
+  // Root layer (ANSI E1.31-2018 section 5) with the given root vector, up to and including the framing vector
+  constexpr void set_root_and_framing(uint8_t root_vector, uint8_t framing_vector) {
+    const uint8_t acn_packet_identifier[12] = {0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00};
+    this->set(0, 0x00);  // Preamble size
+    this->set(1, 0x10);
+    this->set(2, 0x00);  // Postamble size
+    this->set(3, 0x00);
+    for (uint16_t i = 0; i < 12; i++) {
+      this->set(4 + i, acn_packet_identifier[i]);
+    }
+    this->set(16, 0x70, 0xF0);  // Flags, the length is checked separately
+    this->set(18, 0x00);
+    this->set(19, 0x00);
+    this->set(20, 0x00);
+    this->set(21, root_vector);
+    // CID (22-37) is free
+    this->set(38, 0x70, 0xF0);
+    this->set(40, 0x00);
+    this->set(41, 0x00);
+    this->set(42, 0x00);
+    this->set(43, framing_vector);
+  }
+};
+
+// Header of a data packet up to and including the start code
+constexpr E131HeaderTemplate<126> e131_data_template() {
+  E131HeaderTemplate<126> header{};
+  header.set_root_and_framing(0x04, 0x02);  // VECTOR_ROOT_E131_DATA, VECTOR_E131_DATA_PACKET
+  // Source name, priority, sync address, sequence, options and universe (44-114) are free
+  header.set(115, 0x70, 0xF0);
+  // DMP vector (117) is checked separately
+  header.set(118, 0xA1);  // Address type and data type
+  // First property address (119-120) is free, ranges of a universe are accepted
+  header.set(121, 0x00);  // Address increment
+  header.set(122, 0x01);
+  // Property value count (123-124) and start code (125) are free
+  return header;
+}
+
+// A universe synchronization packet
+constexpr E131HeaderTemplate<49> e131_sync_template() {
+  E131HeaderTemplate<49> header{};
+  header.set_root_and_framing(0x08, 0x01);  // VECTOR_ROOT_E131_EXTENDED, VECTOR_E131_EXTENDED_SYNCHRONIZATION
+  // Sequence (44), sync address (45-46) and reserved bytes (47-48) are free
+  return header;
+}
+
+static constexpr E131HeaderTemplate<126> E131_DATA_TEMPLATE = e131_data_template();
+static constexpr E131HeaderTemplate<49> E131_SYNC_TEMPLATE = e131_sync_template();
+
+// Read-only view of a received E1.31 packet. parse() validates the whole header in one pass, after which
+// every accessor stays within the received bytes, however the packet was truncated.
+class E131View {
+ public:
+  static const uint16_t HEADER_SIZE = 126;  // Root + framing + DMP layers up to and including the start code
+  static const uint16_t SYNC_PACKET_SIZE = 49;  // Root + synchronization framing layer
+  static const uint16_t MAX_SLOTS = 512;
+
+  static const uint8_t START_CODE_DMX = 0x00;
+  static const uint8_t START_CODE_ADDRESS_PRIORITY = 0xDD;  // Per-address priority, one byte per DMX slot
+
+  // Framing layer options
+  static const uint8_t OPTION_PREVIEW_DATA = 0x80;  // For visualisers, not for live output
+  static const uint8_t OPTION_STREAM_TERMINATED = 0x40;  // The source stopped sending this universe
+  static const uint8_t OPTION_FORCE_SYNCHRONIZATION = 0x20;
+
+  enum Kind : uint8_t { INVALID = 0, DATA, SYNC };
+
+  constexpr E131View() = default;
+
+  static constexpr E131View parse(const uint8_t *data, uint16_t size) {
+    if (size >= HEADER_SIZE && matches_(data, E131_DATA_TEMPLATE) && pdu_fits_(data, 16, size) &&
+        pdu_fits_(data, 38, size) && pdu_fits_(data, 115, size) && (data[117] == 0x02 || data[117] == 0x04)) {
+      // Property values: the start code plus up to 512 slots, all of them received
+      uint16_t count = (data[123] << 8) | data[124];
+      if (count >= 1 && count <= MAX_SLOTS + 1 && count <= size - (HEADER_SIZE - 1)) {
+        return E131View(data, DATA, count);
+      }
+      return E131View();
+    }
+    if (size >= SYNC_PACKET_SIZE && matches_(data, E131_SYNC_TEMPLATE) && pdu_fits_(data, 16, size) &&
+        pdu_fits_(data, 38, size)) {
+      return E131View(data, SYNC, 0);
+    }
+    return E131View();
+  }
+
+  constexpr bool is_data() const { return this->kind_ == DATA; }
+  constexpr bool is_sync() const { return this->kind_ == SYNC; }
+
+  // Root and framing layers
+  constexpr const uint8_t *cid() const { return this->data_ + 22; }
+  const char *source_name() const { return reinterpret_cast<const char *>(this->data_ + 44); }  // Log with %.64s
+  constexpr uint8_t priority() const { return this->data_[108]; }
+  constexpr uint16_t sync_address() const { return this->is_sync() ? read16_(45) : read16_(109); }
+  constexpr uint8_t sequence() const { return this->is_sync() ? this->data_[44] : this->data_[111]; }
+  constexpr uint8_t options() const { return this->data_[112]; }
+  constexpr bool is_preview() const { return this->options() & OPTION_PREVIEW_DATA; }
+  constexpr bool is_terminated() const { return this->options() & OPTION_STREAM_TERMINATED; }
+  constexpr uint16_t universe() const { return read16_(113); }
+
+  // DMP layer. A source may send a range of a universe, starting at any first property address;
+  // address 0 is the start code, 1-512 the DMX slots.
+  constexpr uint16_t first_address() const { return read16_(119); }
+  constexpr uint8_t start_code() const { return this->first_address() == 0 ? this->data_[125] : 0x00; }
+  // DMX channel (1-based) of dmx()[0]
+  constexpr uint16_t first_channel() const { return this->first_address() == 0 ? 1 : this->first_address(); }
+  // Offset of the first DMX slot from the start of the packet
+  constexpr uint16_t dmx_offset() const { return this->first_address() == 0 ? HEADER_SIZE : HEADER_SIZE - 1; }
+  constexpr const uint8_t *dmx() const { return this->data_ + this->dmx_offset(); }
+  constexpr uint16_t dmx_size() const {
+    uint16_t first = this->first_channel();
+    uint16_t slots = this->first_address() == 0 ? this->count_ - 1 : this->count_;
+    // Slots past channel 512 are dropped
+    if (first > MAX_SLOTS) {
+      return 0;
+    }
+    return first + slots > MAX_SLOTS + 1 ? MAX_SLOTS + 1 - first : slots;
+  }
+
+ protected:
+  constexpr E131View(const uint8_t *data, Kind kind, uint16_t count) : data_(data), count_(count), kind_(kind) {}
+
+  constexpr uint16_t read16_(uint16_t offset) const { return (this->data_[offset] << 8) | this->data_[offset + 1]; }
+
+  // Compares every byte against the template; no early exit, so the loop stays branch free
+  template<uint16_t SIZE> static constexpr bool matches_(const uint8_t *data, const E131HeaderTemplate<SIZE> &header) {
+    uint8_t diff = 0;
+    for (uint16_t i = 0; i < SIZE; i++) {
+      diff |= (data[i] ^ header.value[i]) & header.mask[i];
+    }
+    return diff == 0;
+  }
+
+  // A PDU's length field counts from its own flags and length bytes, which must not reach past the packet
+  static constexpr bool pdu_fits_(const uint8_t *data, uint16_t offset, uint16_t size) {
+    uint16_t length = ((data[offset] & 0x0F) << 8) | data[offset + 1];
+    return length >= 2 && offset + length <= size;
+  }
+
+  const uint8_t *data_{nullptr};
+  uint16_t count_{0};  // Property value count
+  Kind kind_{INVALID};
+};
+
+}  // namespace sacn
+}  // namespace esphome
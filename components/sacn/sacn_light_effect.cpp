@@ -1,5 +1,3 @@
-#ifdef USE_ARDUINO
-
 #include "sacn.h"
 #include "sacn_light_effect.h"
 #include "esphome/core/log.h"
@@ -15,8 +13,8 @@ void SACNLightEffect::start() {
   ESP_LOGD(TAG, "Starting sACN effect for '%s'", this->state_->get_name().c_str());
   
   // Initialize last values
-  for (int i = 0; i < 4; i++) {
-    this->last_values_[i] = 0.0f;
+  for (int i = 0; i < 5; i++) {
+    this->last_levels_[i] = 0;
   }
   
   // Initialize base classes first
@@ -37,9 +35,22 @@ void SACNLightEffect::start() {
     call.perform();
   }
 
+  // Pick the color mode direct writes and fades use, preferring one that covers every channel
+  {
+    auto traits = this->state_->get_traits();
+    this->direct_color_mode_ = this->state_->current_values.get_color_mode();
+    if (this->channel_type_ == SACN_RGBWW && traits.supports_color_mode(light::ColorMode::RGB_COLD_WARM_WHITE)) {
+      this->direct_color_mode_ = light::ColorMode::RGB_COLD_WARM_WHITE;
+    } else if (this->channel_type_ >= SACN_RGBW && traits.supports_color_mode(light::ColorMode::RGB_WHITE)) {
+      this->direct_color_mode_ = light::ColorMode::RGB_WHITE;
+    } else if (this->channel_type_ >= SACN_RGB && traits.supports_color_mode(light::ColorMode::RGB)) {
+      this->direct_color_mode_ = light::ColorMode::RGB;
+    }
+  }
+
   // Reset flags
   this->initial_blank_done_ = false;
-  this->timeout_logged_ = false;
+  this->last_data_valid_ = false;
 }
 
 void SACNLightEffect::stop() {
@@ -63,75 +74,95 @@ void SACNLightEffect::stop() {
 }
 
 void SACNLightEffect::apply() {
-  // If receiving sACN packets times out, blank the output
-  if (this->timeout_check()) {
-    // Only log timeout once when stream stops
-    if (!this->timeout_logged_) {
-      ESP_LOGD(TAG, "sACN stream for '%s->%s' timed out.", this->state_->get_name().c_str(), this->get_name().c_str());
-      this->timeout_logged_ = true;
-      
-      // Blank the light output
-      auto call = this->state_->make_call();
-      call.set_state(true);  // Keep light "on" but...
-      call.set_red_if_supported(0.0f);    // Set all channels
-      call.set_green_if_supported(0.0f);  // to zero for
-      call.set_blue_if_supported(0.0f);   // blank output
-      call.set_white_if_supported(0.0f);
-      call.set_brightness_if_supported(0.0f);
-      call.set_transition_length(0);
-      call.set_publish(false);  // Don't publish this state to HA
-      call.set_save(false);
-      call.perform();
+  SACNStreamState previous = this->stream_state_;
+  SACNStreamState state = this->update_stream_state_();
+  if (state == SACN_STREAM_FADING) {
+    if (previous != SACN_STREAM_FADING) {
+      this->fade_level_ = 0xFFFF;
+      // The output no longer shows the last frame, so the next one is rendered whatever it holds
+      this->last_data_valid_ = false;
     }
-  } else {
-    // Reset timeout log flag when receiving packets
-    this->timeout_logged_ = false;
+    this->render_fade_();
+  } else if (state == SACN_STREAM_RELEASED && previous != SACN_STREAM_RELEASED) {
+    this->blank_();
   }
 
   // Handle initial blanking if enabled
   if (this->blank_on_start_ && !this->initial_blank_done_) {
-    // Blank the light output
-    auto call = this->state_->make_call();
-    call.set_state(true);  // Keep light "on" but...
-    call.set_red_if_supported(0.0f);    // Set all channels
-    call.set_green_if_supported(0.0f);  // to zero for
-    call.set_blue_if_supported(0.0f);   // blank output
-    call.set_white_if_supported(0.0f);
-    call.set_brightness_if_supported(0.0f);
-    call.set_transition_length(0);
-    call.set_publish(false);  // Don't publish this state to HA
-    call.set_save(false);
-    call.perform();
-    
+    this->blank_();
     this->initial_blank_done_ = true;
   }
+
+  // Render the newest frame of the universe, if there is one this effect has not seen
+  this->pull_frames_();
+}
+
+void SACNLightEffect::blank_() {
+  auto call = this->state_->make_call();
+  call.set_state(true);  // Keep light "on" but...
+  call.set_red_if_supported(0.0f);    // Set all channels
+  call.set_green_if_supported(0.0f);  // to zero for
+  call.set_blue_if_supported(0.0f);   // blank output
+  call.set_white_if_supported(0.0f);
+  call.set_brightness_if_supported(0.0f);
+  call.set_transition_length(0);
+  call.set_publish(false);  // Don't publish this state to HA
+  call.set_save(false);
+  call.perform();
+
+  this->last_data_valid_ = false;
+}
+
+void SACNLightEffect::render_fade_() {
+  uint16_t level = this->get_fade_level_(0);
+  if (level == this->fade_level_) {
+    return;
+  }
+  this->fade_level_ = level;
+
+  uint16_t levels[5];
+  for (uint8_t i = 0; i < 5; i++) {
+    levels[i] = (this->last_levels_[i] * (uint32_t) level) >> 8;
+  }
+  this->write_direct_(levels);
 }
 
-uint16_t SACNLightEffect::process_(const uint8_t *payload, uint16_t size, uint16_t used) {
+uint16_t SACNLightEffect::process_(uint16_t universe, const uint8_t *payload, uint16_t size, uint16_t used) {
   // Check if we have enough data based on channel type
-  if (size < (used + this->channel_type_)) {
+  if (size < (used + this->get_channel_footprint_())) {
     return 0;
   }
 
-  this->last_sacn_time_ms_ = millis();
+  this->mark_received_(universe - this->universe_);
+
+  // Unchanged levels need no light call
+  uint16_t footprint = this->get_channel_footprint_();
+  if (this->last_data_valid_ && memcmp(this->last_data_, payload + used, footprint) == 0) {
+    return footprint;
+  }
+  memcpy(this->last_data_, payload + used, footprint);
+  this->last_data_valid_ = true;
+
+  // Map every channel through the response curve once, then scale to the 0.0-1.0 range
+  static const float SCALE = 1.0f / 65535.0f;
+  uint16_t levels[5] = {0, 0, 0, 0, 0};
+  for (uint8_t i = 0; i < this->channel_type_; i++) {
+    levels[i] = this->read_level_(payload + used, i);
+  }
+  memcpy(this->last_levels_, levels, sizeof(levels));
 
-  // Get raw DMX values
-  uint8_t raw_mono = payload[used];
-  uint8_t raw_red = payload[used];
-  uint8_t raw_green = this->channel_type_ >= SACN_RGB ? payload[used + 1] : 0;
-  uint8_t raw_blue = this->channel_type_ >= SACN_RGB ? payload[used + 2] : 0;
-  uint8_t raw_white = this->channel_type_ == SACN_RGBW ? payload[used + 3] : 0;
-  uint8_t raw_cold_white = this->channel_type_ == SACN_RGBWW ? payload[used + 3] : 0;
-  uint8_t raw_warm_white = this->channel_type_ == SACN_RGBWW ? payload[used + 4] : 0;
+  if (this->direct_output_) {
+    this->write_direct_(levels);
+    return this->get_channel_footprint_();
+  }
 
-  // Convert DMX values to float (0.0-1.0)
-  float mono = (float)raw_mono / 255.0f;
-  float red = (float)raw_red / 255.0f;
-  float green = (float)raw_green / 255.0f;
-  float blue = (float)raw_blue / 255.0f;
-  float white = (float)raw_white / 255.0f;
-  float cold_white = (float)raw_cold_white / 255.0f;
-  float warm_white = (float)raw_warm_white / 255.0f;
+  float mono = levels[0] * SCALE;
+  float red = levels[0] * SCALE;
+  float green = levels[1] * SCALE;
+  float blue = levels[2] * SCALE;
+  float white = this->channel_type_ == SACN_RGBW ? levels[3] * SCALE : 0.0f;
+  float cold_white = this->channel_type_ == SACN_RGBWW ? levels[3] * SCALE : 0.0f;
+  float warm_white = this->channel_type_ == SACN_RGBWW ? levels[4] * SCALE : 0.0f;
 
   // Create a new light state call
   auto call = this->state_->turn_on();
@@ -205,10 +236,72 @@ uint16_t SACNLightEffect::process_(const uint8_t *payload, uint16_t size, uint16
   // Manually call loop to ensure immediate update
   this->state_->loop();
 
-  return this->channel_type_;
+  return this->get_channel_footprint_();
+}
+
+uint16_t SACNLightEffect::read_level_(const uint8_t *data, uint8_t channel) const {
+  const uint16_t *curve = this->response_curve_;
+
+  if (!this->fine_channels_) {
+    uint8_t value = data[channel];
+    return curve != nullptr ? curve[value] : value * 257;
+  }
+
+  uint16_t value = (data[2 * channel] << 8) | data[2 * channel + 1];
+  if (curve == nullptr) {
+    return value;
+  }
+
+  // Position in the 256-entry table in 16.16 fixed point, i.e. value * 255 / 65535.
+  // Coarse-only levels (value = coarse * 257) land exactly on a table entry.
+  uint32_t pos = value * 255u + value / 257u;
+  uint8_t index = pos >> 16;
+  if (index == 255) {
+    return curve[255];
+  }
+  int32_t delta = (int32_t) curve[index + 1] - curve[index];
+  return curve[index] + ((delta * (int32_t) ((pos & 0xFFFF) >> 1)) >> 15);
+}
+
+void SACNLightEffect::write_direct_(const uint16_t *levels) {
+  // Levels stay integer until the single scale to the 0.0-1.0 range LightColorValues uses
+  static const float SCALE = 1.0f / 65535.0f;
+
+  // Levels past the channel type are zero
+  uint16_t red = levels[0];
+  uint16_t green = levels[1];
+  uint16_t blue = levels[2];
+  uint16_t cold_white = levels[3];
+  uint16_t warm_white = this->channel_type_ == SACN_RGBWW ? levels[4] : cold_white;
+
+  // Written in place: no validation, transition or publishing. LightState is brought back
+  // in line by the LightCall on timeout.
+  auto &values = this->state_->current_values;
+  values.set_color_mode(this->direct_color_mode_);
+  values.set_state(1.0f);
+
+  if (this->channel_type_ == SACN_MONO) {
+    values.set_brightness(red * SCALE);
+    values.set_color_brightness(1.0f);
+    values.set_red(1.0f);
+    values.set_green(1.0f);
+    values.set_blue(1.0f);
+    values.set_white(1.0f);
+    values.set_cold_white(1.0f);
+    values.set_warm_white(1.0f);
+  } else {
+    values.set_brightness(1.0f);
+    values.set_color_brightness(1.0f);
+    values.set_red(red * SCALE);
+    values.set_green(green * SCALE);
+    values.set_blue(blue * SCALE);
+    values.set_white(std::max(cold_white, warm_white) * SCALE);
+    values.set_cold_white(cold_white * SCALE);
+    values.set_warm_white(warm_white * SCALE);
+  }
+
+  this->state_->get_output()->write_state(this->state_);
 }
 
 }  // namespace sacn
 }  // namespace esphome
-
-#endif  // USE_ARDUINO
\ No newline at end of file
@@ -1,7 +1,5 @@
 #pragma once
 
-#ifdef USE_ARDUINO
-
 #include "esphome/core/component.h"
 #include "esphome/components/light/light_effect.h"
 #include "esphome/components/light/light_output.h"
@@ -12,7 +10,7 @@ namespace sacn {
 
 class SACNLightEffect : public SACNLightEffectBase, public light::LightEffect {
  public:
-  SACNLightEffect(const std::string &name) : LightEffect(name), timeout_logged_(false), blank_on_start_(true) {}
+  SACNLightEffect(const std::string &name) : LightEffect(name), blank_on_start_(true) {}
 
   const std::string &get_name() override;
 
@@ -20,22 +18,46 @@ class SACNLightEffect : public SACNLightEffectBase, public light::LightEffect {
   void stop() override;
   void apply() override;
   void set_blank_on_start(bool blank) { this->blank_on_start_ = blank; }
+  void set_direct_output(bool direct_output) { this->direct_output_ = direct_output; }
+  void set_response_curve(const uint16_t *response_curve) { this->response_curve_ = response_curve; }
+  void set_fine_channels(bool fine_channels) { this->fine_channels_ = fine_channels; }
 
  protected:
-  uint16_t process_(const uint8_t *payload, uint16_t size, uint16_t used) override;
-  
-  // Store the last received values for each channel
-  float last_values_[5] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f};  // RGBWW values
+  uint16_t process_(uint16_t universe, const uint8_t *payload, uint16_t size, uint16_t used) override;
+  uint16_t get_channel_footprint_() const override {
+    return this->fine_channels_ ? this->channel_type_ * 2 : this->channel_type_;
+  }
+
+  // Reads one (coarse/fine) channel as a 16-bit level mapped through the response curve
+  uint16_t read_level_(const uint8_t *data, uint8_t channel) const;
+
+  // Writes 16-bit levels straight to the light output, bypassing LightCall
+  void write_direct_(const uint16_t *levels);
+  // Writes last_levels_ scaled down to the current fade level, if it changed
+  void render_fade_();
+  // Blanks the light through a LightCall, bringing LightState back in line
+  void blank_();
+
+  // Levels of the last rendered frame, the starting point of a fade
+  uint16_t last_levels_[5] = {0, 0, 0, 0, 0};  // RGBWW values
+  uint16_t fade_level_{0};  // Level last written while fading
   
+  // Channel data of the last rendered packet; retransmissions of it only keep the stream alive
+  uint8_t last_data_[10];  // RGBWW with fine channels
+  bool last_data_valid_{false};
+
   // Store the last time we logged (for rate limiting logs)
   uint32_t last_log_time_ms_{0};
 
-  bool timeout_logged_{false};  // Track if timeout has been logged
   bool blank_on_start_{true};  // Default to true for backward compatibility
   bool initial_blank_done_{false};  // Track if we've done the initial blank
+
+  bool direct_output_{false};
+  light::ColorMode direct_color_mode_{light::ColorMode::UNKNOWN};  // Color mode used for direct writes and fades
+
+  const uint16_t *response_curve_{nullptr};  // 256 output levels generated at build time, nullptr for linear
+  bool fine_channels_{false};  // Each channel is a coarse/fine pair of DMX slots
 };
 
 }  // namespace sacn
 }  // namespace esphome
-
-#endif  // USE_ARDUINO
\ No newline at end of file
@@ -1,14 +1,19 @@
-#ifdef USE_ARDUINO
-
 #include "sacn.h"
 #include "sacn_light_effect_base.h"
+#include "esphome/core/log.h"
 
 namespace esphome {
 namespace sacn {
 
+static const char *const TAG = "sacn_light_effect_base";
+
 SACNLightEffectBase::SACNLightEffectBase() {}
 
 void SACNLightEffectBase::start() {
+  this->frame_generations_.assign(this->universe_count_, 0);
+  this->converted_generations_.assign(this->universe_count_, 0);
+  this->streams_.assign(this->universe_count_, SACNStream());
+  this->stream_state_ = SACN_STREAM_RELEASED;
   if (this->sacn_) {
     this->sacn_->add_effect(this);
   }
@@ -20,27 +25,79 @@ void SACNLightEffectBase::stop() {
   }
 }
 
-// Returns true if this effect has timed out (no sACN data received within timeout period)
-bool SACNLightEffectBase::timeout_check() {
-  // Don't timeout if timeout is disabled
-  if (this->timeout_ == 0) {
-    return false;
+void SACNLightEffectBase::pull_frames_() {
+  if (this->sacn_ && this->protocol_ == SACN_E131) {
+    this->sacn_->pull_frames(this);
+  }
+}
+
+void SACNLightEffectBase::mark_received_(uint8_t universe_index) {
+  SACNStream &stream = this->streams_[universe_index];
+  stream.last_ms = millis();
+  if (stream.state == SACN_STREAM_HOLD || stream.state == SACN_STREAM_FADING) {
+    ESP_LOGD(TAG, "sACN stream for '%s' resumed on universe %d", this->get_name().c_str(),
+             this->universe_ + universe_index);
+  }
+  stream.state = SACN_STREAM_RECEIVING;
+  stream.fade_level = NOT_FADING;
+  stream.lost = false;
+  this->stream_state_ = SACN_STREAM_RECEIVING;
+}
+
+void SACNLightEffectBase::terminate_stream_(uint16_t universe) {
+  uint16_t index = universe - this->universe_;
+  if (index >= this->streams_.size()) {
+    return;
+  }
+  SACNStream &stream = this->streams_[index];
+  if (stream.state == SACN_STREAM_RECEIVING) {
+    stream.last_ms = millis() - this->timeout_ - 1;
   }
+}
 
-  // Don't timeout if no sACN data was ever received
-  if (this->last_sacn_time_ms_ == 0) {
-    return false;
+SACNStreamState SACNLightEffectBase::update_stream_state_() {
+  // Nothing to lose before the first frame, or with the timeout disabled
+  if (this->stream_state_ == SACN_STREAM_RELEASED || this->timeout_ == 0) {
+    return this->stream_state_;
   }
 
-  // Check if we've exceeded the timeout period
-  if ((millis() - this->last_sacn_time_ms_) <= this->timeout_) {
-    return false;
+  // The state follows from the time since the last frame, so states apply() never saw are skipped
+  uint32_t now = millis();
+  SACNStreamState effect_state = SACN_STREAM_RELEASED;
+  for (uint8_t i = 0; i < this->streams_.size(); i++) {
+    SACNStream &stream = this->streams_[i];
+    if (stream.state != SACN_STREAM_RELEASED) {
+      uint32_t silent = now - stream.last_ms;
+      SACNStreamState state = SACN_STREAM_RECEIVING;
+      if (silent > this->timeout_ + this->hold_time_ + this->fade_time_) {
+        state = SACN_STREAM_RELEASED;
+      } else if (silent > this->timeout_ + this->hold_time_) {
+        state = SACN_STREAM_FADING;
+      } else if (silent > this->timeout_) {
+        state = SACN_STREAM_HOLD;
+      }
+
+      if (state != stream.state) {
+        static const char *const STATES[] = {"receiving", "holding last look", "fading out", "released"};
+        ESP_LOGD(TAG, "sACN stream for '%s' %s on universe %d", this->get_name().c_str(), STATES[state],
+                 this->universe_ + i);
+        stream.state = state;
+        stream.lost = true;
+      }
+    }
+    effect_state = std::min(effect_state, stream.state);
   }
+  this->stream_state_ = effect_state;
+  return effect_state;
+}
 
-  return true;
+uint16_t SACNLightEffectBase::get_fade_level_(uint8_t universe_index) const {
+  uint32_t elapsed = millis() - this->streams_[universe_index].last_ms - this->timeout_ - this->hold_time_;
+  if (elapsed >= this->fade_time_) {
+    return 0;
+  }
+  return 256 - elapsed * 256 / this->fade_time_;
 }
 
 }  // namespace sacn
 }  // namespace esphome
-
-#endif  // USE_ARDUINO 
\ No newline at end of file
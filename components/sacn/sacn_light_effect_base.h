@@ -1,11 +1,11 @@
 #pragma once
 
-#ifdef USE_ARDUINO
-
 #include "esphome/core/component.h"
 #include "esphome/components/light/light_effect.h"
 #include "esphome/components/light/light_output.h"
 
+#include <vector>
+
 namespace esphome {
 namespace sacn {
 
@@ -23,6 +23,20 @@ enum SACNTransportMode {
   SACN_MULTICAST = 1
 };
 
+// Loss-of-signal handling. Once no frame arrived for `timeout`, the last look is held for `hold_time`,
+// faded out over `fade_time`, then the light is released.
+enum SACNStreamState {
+  SACN_STREAM_RECEIVING = 0,
+  SACN_STREAM_HOLD = 1,
+  SACN_STREAM_FADING = 2,
+  SACN_STREAM_RELEASED = 3
+};
+
+enum SACNProtocol {
+  SACN_E131 = 0,  // sACN universes on port 5568
+  SACN_DDP = 1    // DDP byte stream on port 4048, addressable effects only
+};
+
 class SACNLightEffectBase {
  public:
   SACNLightEffectBase();
@@ -31,37 +45,86 @@ class SACNLightEffectBase {
 
   virtual void start();
   virtual void stop();
-  bool timeout_check();
 
   void set_sacn(SACNComponent *sacn) { this->sacn_ = sacn; }
   void set_timeout(uint32_t timeout) { this->timeout_ = timeout; }
+  void set_hold_time(uint32_t hold_time) { this->hold_time_ = hold_time; }
+  void set_fade_time(uint32_t fade_time) { this->fade_time_ = fade_time; }
   void set_universe(uint16_t universe) { this->universe_ = universe; }
+  void set_universe_count(uint8_t universe_count) { this->universe_count_ = universe_count; }
   void set_start_channel(uint16_t start_channel) { this->start_channel_ = start_channel; }
   void set_channel_type(SACNChannelType channel_type) { this->channel_type_ = channel_type; }
   void set_transport_mode(SACNTransportMode transport_mode) { this->transport_mode_ = transport_mode; }
+  void set_protocol(SACNProtocol protocol) { this->protocol_ = protocol; }
 
   // Getters for configuration
   uint16_t get_universe() const { return this->universe_; }
+  uint16_t get_first_universe() const { return this->universe_; }
+  uint16_t get_last_universe() const { return this->universe_ + this->universe_count_ - 1; }
   uint16_t get_start_channel() const { return this->start_channel_; }
   SACNChannelType get_channel_type() const { return this->channel_type_; }
   SACNTransportMode get_transport_mode() const { return this->transport_mode_; }
+  SACNProtocol get_protocol() const { return this->protocol_; }
 
  protected:
   SACNComponent *sacn_{nullptr};
 
   uint32_t timeout_{2500};  // Default timeout 2.5s
-  uint32_t last_sacn_time_ms_{0};
+  uint32_t hold_time_{0};
+  uint32_t fade_time_{0};
+  // Each universe loses its stream on its own, so a dead universe fades while the others carry on
+  static const uint16_t NOT_FADING = 0xFFFF;
+  struct SACNStream {
+    SACNStreamState state{SACN_STREAM_RELEASED};
+    uint32_t last_ms{0};  // Time of the last frame
+    uint16_t fade_level{NOT_FADING};  // Level last written while fading
+    bool lost{false};  // Timed out or terminated since the last frame, as opposed to never received
+  };
+  std::vector<SACNStream> streams_;  // By universe index; a DDP stream counts as one universe
+  SACNStreamState stream_state_{SACN_STREAM_RELEASED};  // Of the effect as a whole, its most active universe
+
+  // Records that a frame of the n-th universe arrived, which puts its stream back into SACN_STREAM_RECEIVING
+  void mark_received_(uint8_t universe_index);
+  // Ends a universe's stream as though the timeout had just passed, for sources that announce they stopped. The
+  // other universes carry on.
+  void terminate_stream_(uint16_t universe);
+  // Advances the state of each universe by the time since its last frame, called from apply(). Returns the
+  // state of the effect as a whole, which is only released once every universe is.
+  SACNStreamState update_stream_state_();
+  // Output level of the n-th universe while fading, from 256 (the last look) down to 0
+  uint16_t get_fade_level_(uint8_t universe_index) const;
+
   uint16_t universe_{1};  // Default universe 1
+  uint8_t universe_count_{1};  // Number of consecutive universes, starting at universe_
   uint16_t start_channel_{1};  // Default start channel 1
   SACNChannelType channel_type_{SACN_RGB};  // Default to RGB
   SACNTransportMode transport_mode_{SACN_UNICAST};  // Default to unicast
-
-  virtual uint16_t process_(const uint8_t *payload, uint16_t size, uint16_t used) = 0;
+  SACNProtocol protocol_{SACN_E131};
+
+  // Offset of this effect's first channel within the DMX data of the given universe
+  uint16_t get_channel_offset_(uint16_t universe) const {
+    return universe == this->universe_ ? this->start_channel_ - 1 : 0;
+  }
+
+  // Number of DMX channels one fixture of this effect occupies
+  virtual uint16_t get_channel_footprint_() const { return this->channel_type_; }
+
+  // Pulls the frames of this effect's universes from the component, called from apply()
+  void pull_frames_();
+  std::vector<uint32_t> frame_generations_;  // Generation of the frame last pulled, per universe
+  // Generation of the frame last handed to process_(), per universe. 0 has the next frame processed even when
+  // its data did not change, as once the light no longer shows it.
+  std::vector<uint32_t> converted_generations_;
+
+  virtual uint16_t process_(uint16_t universe, const uint8_t *payload, uint16_t size, uint16_t used) = 0;
+  // Called instead of process_() for a frame whose data did not change since this effect last processed the
+  // universe. Returns false to have it processed anyway.
+  virtual bool refresh_(uint16_t universe) { return false; }
+  // DDP data starting `offset` bytes into the stream; push shows everything received since the last push
+  virtual uint16_t process_ddp_(uint32_t offset, const uint8_t *data, uint16_t size, bool push) { return 0; }
 
   friend class SACNComponent;
 };
 
 }  // namespace sacn
 }  // namespace esphome
-
-#endif  // USE_ARDUINO
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace esphome {
+namespace sacn {
+
+// Merges one source into the running result of a per-address priority merge. Each address takes the level of the
+// highest priority source, equal priorities merge highest-takes-precedence, and priority 0 means the source does
+// not drive that address. Start from all zero levels and priorities, then merge every source in any order.
+// One address at a time; the reference for sacn_merge_priority() and its tail.
+inline void sacn_merge_priority_bytes(uint8_t *__restrict levels, uint8_t *__restrict priorities,
+                                      const uint8_t *__restrict source_levels,
+                                      const uint8_t *__restrict source_priorities, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    uint8_t priority = priorities[i];
+    uint8_t source_priority = source_priorities[i];
+    uint8_t level = levels[i];
+    uint8_t source_level = source_priority != 0 ? source_levels[i] : 0;
+
+    uint8_t highest = source_level > level ? source_level : level;
+    uint8_t winner = source_priority > priority ? source_level : level;
+    levels[i] = source_priority == priority ? highest : winner;
+    priorities[i] = source_priority > priority ? source_priority : priority;
+  }
+}
+
+// Byte lanes for sacn_merge_priority(): four addresses per uint32_t, each comparison leaving the top bit of a lane set
+// where it holds
+static const uint32_t SACN_LANE_LOW = 0x7F7F7F7F;
+static const uint32_t SACN_LANE_HIGH = 0x80808080;
+
+// Always inlined: called more than once per iteration, -Os would otherwise make each a function call
+__attribute__((always_inline)) inline uint32_t sacn_lanes_nonzero(uint32_t x) {
+  return (((x & SACN_LANE_LOW) + SACN_LANE_LOW) | x) & SACN_LANE_HIGH;
+}
+
+// Unsigned a > b. The low seven bits are compared by a subtraction that cannot borrow across lanes, the top bits
+// decide where they differ.
+__attribute__((always_inline)) inline uint32_t sacn_lanes_greater(uint32_t a, uint32_t b) {
+  uint32_t low_at_least = (b | SACN_LANE_HIGH) - (a & SACN_LANE_LOW);  // b's low bits >= a's
+  return ~((b & ~a) | (~(a ^ b) & low_at_least)) & SACN_LANE_HIGH;
+}
+
+// Spreads the top bit of each lane over the whole lane
+__attribute__((always_inline)) inline uint32_t sacn_lanes_mask(uint32_t top_bits) {
+  return (top_bits >> 7) * 0xFF;
+}
+
+// sacn_merge_priority_bytes() on four addresses at a time in 32-bit registers. Xtensa has no SIMD unit and GCC does
+// not vectorize at -Os, so the lanes are explicit rather than left to the compiler.
+// The merge is a maximum of (priority, level) pairs: a source takes an address with a higher priority, or with
+// an equal one and a higher level.
+inline void sacn_merge_priority(uint8_t *__restrict levels, uint8_t *__restrict priorities,
+                                const uint8_t *__restrict source_levels, const uint8_t *__restrict source_priorities,
+                                size_t size) {
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    // The buffers are at any DMX offset, memcpy keeps the loads and stores free of alignment assumptions
+    uint32_t source_priority;
+    memcpy(&source_priority, source_priorities + i, 4);
+    // Addresses the source does not drive, as when sources split a universe between them
+    if (source_priority == 0) {
+      continue;
+    }
+    uint32_t level, priority, source_level;
+    memcpy(&level, levels + i, 4);
+    memcpy(&priority, priorities + i, 4);
+    memcpy(&source_level, source_levels + i, 4);
+
+    source_level &= sacn_lanes_mask(sacn_lanes_nonzero(source_priority));
+    uint32_t equal = ~sacn_lanes_nonzero(source_priority ^ priority);
+    uint32_t take = sacn_lanes_greater(source_priority, priority) |
+                    (equal & sacn_lanes_greater(source_level, level));
+    take = sacn_lanes_mask(take & SACN_LANE_HIGH);
+    level ^= (source_level ^ level) & take;
+    priority ^= (source_priority ^ priority) & take;
+
+    memcpy(levels + i, &level, 4);
+    memcpy(priorities + i, &priority, 4);
+  }
+  sacn_merge_priority_bytes(levels + i, priorities + i, source_levels + i, source_priorities + i, size - i);
+}
+
+}  // namespace sacn
+}  // namespace esphome
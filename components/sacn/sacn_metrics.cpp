@@ -0,0 +1,127 @@
+#include "sacn_metrics.h"
+#include "esphome/core/log.h"
+
+#include <cinttypes>
+
+namespace esphome {
+namespace sacn {
+
+static const char *const TAG = "sacn_metrics";
+
+SACNUniverseStats SACNMetrics::collect_() const {
+  SACNUniverseStats total;
+  for (const auto &route : this->sacn_->get_universes()) {
+    if (this->universe_ != 0 && route.universe != this->universe_) {
+      continue;
+    }
+    total.packets += route.stats.packets;
+    total.gaps += route.stats.gaps;
+    total.duplicates += route.stats.duplicates;
+    total.out_of_order += route.stats.out_of_order;
+    total.lower_priority += route.stats.lower_priority;
+    total.frames += route.stats.frames;
+    total.jitter_us = std::max(total.jitter_us, route.stats.jitter_us);  // Worst universe
+  }
+  return total;
+}
+
+void SACNMetrics::setup() {
+#ifdef USE_SENSOR
+  if (this->loop_time_max_sensor_ != nullptr) {
+    this->busy_max_reader_ = this->sacn_->add_busy_max_reader();
+  }
+#endif
+}
+
+void SACNMetrics::update() {
+#if defined(USE_SENSOR) || defined(USE_TEXT_SENSOR)
+  const SACNComponentStats &stats = this->sacn_->get_stats();
+  SACNUniverseStats universes = this->collect_();
+#endif
+
+#ifdef USE_SENSOR
+  // Packets accepted by validation and arbitration
+  uint32_t valid = universes.packets - universes.dropped();
+  // For all universes, received counts every datagram and dropped every one rejected before reaching a universe too
+  uint32_t received = universes.packets;
+  uint32_t dropped = universes.dropped();
+  if (this->universe_ == 0) {
+    received = stats.packets;
+    dropped += stats.malformed + stats.unbound + stats.start_code + stats.preview;
+  }
+
+  // loop() timing covers the whole component
+  uint32_t busy_loops = stats.busy_loops - this->last_busy_loops_;
+  uint32_t busy_us = stats.busy_us - this->last_busy_us_;
+  this->last_busy_loops_ = stats.busy_loops;
+  this->last_busy_us_ = stats.busy_us;
+
+  if (this->packets_received_sensor_ != nullptr) {
+    this->packets_received_sensor_->publish_state(received);
+  }
+  if (this->packets_valid_sensor_ != nullptr) {
+    this->packets_valid_sensor_->publish_state(valid);
+  }
+  if (this->packets_dropped_sensor_ != nullptr) {
+    this->packets_dropped_sensor_->publish_state(dropped);
+  }
+  if (this->sequence_gaps_sensor_ != nullptr) {
+    this->sequence_gaps_sensor_->publish_state(universes.gaps);
+  }
+  if (this->frames_applied_sensor_ != nullptr) {
+    this->frames_applied_sensor_->publish_state(universes.frames);
+  }
+  if (this->loop_time_avg_sensor_ != nullptr) {
+    this->loop_time_avg_sensor_->publish_state(busy_loops > 0 ? busy_us / 1000.0f / busy_loops : 0.0f);
+  }
+  if (this->loop_time_max_sensor_ != nullptr) {
+    this->loop_time_max_sensor_->publish_state(this->sacn_->take_busy_max_us(this->busy_max_reader_) / 1000.0f);
+  }
+  if (this->jitter_sensor_ != nullptr) {
+    this->jitter_sensor_->publish_state(universes.jitter_us / 1000.0f);
+  }
+#endif
+
+#ifdef USE_TEXT_SENSOR
+  if (this->drop_reasons_text_sensor_ != nullptr) {
+    char buffer[192];
+    if (this->universe_ == 0) {
+      snprintf(buffer, sizeof(buffer),
+               "malformed %" PRIu32 ", unbound %" PRIu32 ", start code %" PRIu32 ", preview %" PRIu32
+               ", duplicate %" PRIu32 ", out of order %" PRIu32 ", priority %" PRIu32,
+               stats.malformed, stats.unbound, stats.start_code, stats.preview, universes.duplicates,
+               universes.out_of_order, universes.lower_priority);
+    } else {
+      snprintf(buffer, sizeof(buffer), "duplicate %" PRIu32 ", out of order %" PRIu32 ", priority %" PRIu32,
+               universes.duplicates, universes.out_of_order, universes.lower_priority);
+    }
+    this->drop_reasons_text_sensor_->publish_state(buffer);
+  }
+#endif
+}
+
+void SACNMetrics::dump_config() {
+  ESP_LOGCONFIG(TAG, "sACN Metrics:");
+  if (this->universe_ != 0) {
+    ESP_LOGCONFIG(TAG, "  Universe: %d", this->universe_);
+  } else {
+    ESP_LOGCONFIG(TAG, "  Universe: all");
+  }
+  LOG_UPDATE_INTERVAL(this);
+#ifdef USE_SENSOR
+  LOG_SENSOR("  ", "Packets Received", this->packets_received_sensor_);
+  LOG_SENSOR("  ", "Packets Valid", this->packets_valid_sensor_);
+  LOG_SENSOR("  ", "Packets Dropped", this->packets_dropped_sensor_);
+  LOG_SENSOR("  ", "Sequence Gaps", this->sequence_gaps_sensor_);
+  LOG_SENSOR("  ", "Frames Applied", this->frames_applied_sensor_);
+  LOG_SENSOR("  ", "Loop Time Avg", this->loop_time_avg_sensor_);
+  LOG_SENSOR("  ", "Loop Time Max", this->loop_time_max_sensor_);
+  LOG_SENSOR("  ", "Jitter", this->jitter_sensor_);
+#endif
+#ifdef USE_TEXT_SENSOR
+  LOG_TEXT_SENSOR("  ", "Drop Reasons", this->drop_reasons_text_sensor_);
+#endif
+}
+
+}  // namespace sacn
+}  // namespace esphome
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+#include "sacn.h"
+
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+#ifdef USE_TEXT_SENSOR
+#include "esphome/components/text_sensor/text_sensor.h"
+#endif
+
+namespace esphome {
+namespace sacn {
+
+// Publishes the receive counters of a SACNComponent, for one universe or all of them
+class SACNMetrics : public PollingComponent {
+ public:
+  explicit SACNMetrics(SACNComponent *sacn) : sacn_(sacn) {}
+
+  void setup() override;
+  void update() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::DATA; }
+
+  void set_universe(uint16_t universe) { this->universe_ = universe; }
+
+#ifdef USE_SENSOR
+  void set_packets_received_sensor(sensor::Sensor *sensor) { this->packets_received_sensor_ = sensor; }
+  void set_packets_valid_sensor(sensor::Sensor *sensor) { this->packets_valid_sensor_ = sensor; }
+  void set_packets_dropped_sensor(sensor::Sensor *sensor) { this->packets_dropped_sensor_ = sensor; }
+  void set_sequence_gaps_sensor(sensor::Sensor *sensor) { this->sequence_gaps_sensor_ = sensor; }
+  void set_frames_applied_sensor(sensor::Sensor *sensor) { this->frames_applied_sensor_ = sensor; }
+  void set_loop_time_avg_sensor(sensor::Sensor *sensor) { this->loop_time_avg_sensor_ = sensor; }
+  void set_loop_time_max_sensor(sensor::Sensor *sensor) { this->loop_time_max_sensor_ = sensor; }
+  void set_jitter_sensor(sensor::Sensor *sensor) { this->jitter_sensor_ = sensor; }
+#endif
+#ifdef USE_TEXT_SENSOR
+  void set_drop_reasons_text_sensor(text_sensor::TextSensor *text_sensor) {
+    this->drop_reasons_text_sensor_ = text_sensor;
+  }
+#endif
+
+ protected:
+  // Sum of the universe counters this instance reports on
+  SACNUniverseStats collect_() const;
+
+  SACNComponent *sacn_;
+  uint16_t universe_{0};  // 0 for all universes
+
+  // Snapshot at the previous update, for the average loop time over the interval
+  uint32_t last_busy_loops_{0};
+  uint32_t last_busy_us_{0};
+  uint8_t busy_max_reader_{0};  // Slot of the component's running maximums read by this instance
+
+#ifdef USE_SENSOR
+  sensor::Sensor *packets_received_sensor_{nullptr};
+  sensor::Sensor *packets_valid_sensor_{nullptr};
+  sensor::Sensor *packets_dropped_sensor_{nullptr};
+  sensor::Sensor *sequence_gaps_sensor_{nullptr};
+  sensor::Sensor *frames_applied_sensor_{nullptr};
+  sensor::Sensor *loop_time_avg_sensor_{nullptr};
+  sensor::Sensor *loop_time_max_sensor_{nullptr};
+  sensor::Sensor *jitter_sensor_{nullptr};
+#endif
+#ifdef USE_TEXT_SENSOR
+  text_sensor::TextSensor *drop_reasons_text_sensor_{nullptr};
+#endif
+};
+
+}  // namespace sacn
+}  // namespace esphome
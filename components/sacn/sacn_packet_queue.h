@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace sacn {
+
+// Lock-free single-producer/single-consumer ring of preallocated packet slots.
+// The producer fills the slot returned by acquire() and publishes it with push(),
+// the consumer reads front() and releases it with pop(). N must be a power of two.
+// Each slot carries its sender, as the transport only remembers the last one.
+template<size_t N, size_t SLOT_SIZE> class SACNPacketQueue {
+  static_assert((N & (N - 1)) == 0, "SACNPacketQueue size must be a power of two");
+
+ public:
+  // Producer: free slot to receive into, or nullptr when the queue is full
+  uint8_t *acquire() {
+    uint32_t head = this->head_.load(std::memory_order_relaxed);
+    if (head - this->tail_.load(std::memory_order_acquire) >= N) {
+      return nullptr;
+    }
+    return this->slots_[head & (N - 1)].data;
+  }
+
+  // Producer: publish the slot returned by acquire(), received from `from`
+  void push(uint16_t size, uint32_t from) {
+    uint32_t head = this->head_.load(std::memory_order_relaxed);
+    this->slots_[head & (N - 1)].size = size;
+    this->slots_[head & (N - 1)].from = from;
+    this->head_.store(head + 1, std::memory_order_release);
+  }
+
+  // Consumer: oldest published slot, or nullptr when the queue is empty
+  uint8_t *front(uint16_t *size, uint32_t *from) {
+    uint32_t tail = this->tail_.load(std::memory_order_relaxed);
+    if (tail == this->head_.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    Slot &slot = this->slots_[tail & (N - 1)];
+    *size = slot.size;
+    *from = slot.from;
+    return slot.data;
+  }
+
+  // Consumer: hand the slot returned by front() back to the producer
+  void pop() { this->tail_.store(this->tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+ protected:
+  struct Slot {
+    uint16_t size;
+    uint32_t from;  // Sender, as from SACNTransport::get_remote_ip()
+    uint8_t data[SLOT_SIZE];
+  };
+
+  Slot slots_[N];
+  std::atomic<uint32_t> head_{0};  // Written by the producer only
+  std::atomic<uint32_t> tail_{0};  // Written by the consumer only
+};
+
+}  // namespace sacn
+}  // namespace esphome
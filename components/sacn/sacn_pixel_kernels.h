@@ -0,0 +1,122 @@
+#pragma once
+
+#include "esphome/components/light/addressable_light.h"
+#include "sacn_light_effect_base.h"
+
+#include <algorithm>
+
+namespace esphome {
+namespace sacn {
+
+// Order of the red, green and blue slots within a pixel's DMX data
+enum SACNChannelOrder {
+  SACN_ORDER_RGB = 0,
+  SACN_ORDER_RBG = 1,
+  SACN_ORDER_GRB = 2,
+  SACN_ORDER_GBR = 3,
+  SACN_ORDER_BRG = 4,
+  SACN_ORDER_BGR = 5
+};
+
+// One LED fed from the pixel whose DMX data starts `offset` bytes into the universe data (or DDP stream)
+struct SACNPixelMapEntry {
+  uint16_t led;
+  uint16_t offset;
+};
+
+// Pixels are written either straight to the strip or into a frame buffer indexed by LED
+inline void sacn_write_pixel(light::AddressableLight &it, uint16_t led, const Color &color) { it[led].set(color); }
+inline void sacn_write_pixel(Color *frame, uint16_t led, const Color &color) { frame[led] = color; }
+
+// Converts `count` pixels of DMX data and writes them starting at LED `first`
+template<typename Sink>
+using SACNPixelKernel = void (*)(const uint8_t *data, uint16_t count, Sink sink, uint16_t first);
+// Writes `count` LEDs of a precomputed pixel map, converting the pixel data each entry points at.
+// `base` is the offset of data[0] within the universe data.
+template<typename Sink>
+using SACNPixelGather = void (*)(const uint8_t *data, uint16_t base, const SACNPixelMapEntry *map, uint16_t count,
+                                 Sink sink);
+
+template<typename Sink> struct SACNPixelKernels {
+  SACNPixelKernel<Sink> convert{nullptr};
+  SACNPixelGather<Sink> gather{nullptr};
+};
+
+// Conversion kernels for one channel layout; R, G and B are the slot offsets of each color.
+// Everything is resolved at compile time, leaving a straight integer loop per instantiation.
+template<SACNChannelType TYPE, uint8_t R, uint8_t G, uint8_t B> struct SACNPixelLayout {
+  static Color color(const uint8_t *data) {
+    if (TYPE == SACN_MONO) {
+      return Color(data[0], data[0], data[0], 0);
+    } else if (TYPE == SACN_RGB) {
+      return Color(data[R], data[G], data[B], 0);
+    } else if (TYPE == SACN_RGBW) {
+      return Color(data[R], data[G], data[B], data[3]);
+    }
+    // Strips have a single white channel, so RGBWW drives it with the higher of cold and warm white
+    return Color(data[R], data[G], data[B], std::max(data[3], data[4]));
+  }
+
+  template<typename Sink> static void convert(const uint8_t *data, uint16_t count, Sink sink, uint16_t first) {
+    for (uint16_t i = 0; i < count; i++, data += TYPE) {
+      sacn_write_pixel(sink, first + i, color(data));
+    }
+  }
+
+  template<typename Sink>
+  static void gather(const uint8_t *data, uint16_t base, const SACNPixelMapEntry *map, uint16_t count, Sink sink) {
+    for (uint16_t i = 0; i < count; i++) {
+      sacn_write_pixel(sink, map[i].led, color(data + (map[i].offset - base)));
+    }
+  }
+
+  template<typename Sink> static SACNPixelKernels<Sink> kernels() { return {convert<Sink>, gather<Sink>}; }
+};
+
+// Blends `from` towards `to` by t / 256 per byte. Past 256 the fade is extrapolated, clamped to the byte range.
+// A plain integer loop over bytes, so the compiler can vectorize it.
+inline void sacn_blend_pixels(const uint8_t *__restrict from, const uint8_t *__restrict to, uint8_t *__restrict out,
+                              size_t size, int32_t t) {
+  for (size_t i = 0; i < size; i++) {
+    int32_t value = from[i] + (((to[i] - from[i]) * t) >> 8);
+    out[i] = value < 0 ? 0 : (value > 255 ? 255 : value);
+  }
+}
+
+template<typename Sink, SACNChannelType TYPE>
+SACNPixelKernels<Sink> sacn_select_pixel_kernels(SACNChannelOrder order) {
+  switch (order) {
+    case SACN_ORDER_RBG:
+      return SACNPixelLayout<TYPE, 0, 2, 1>::template kernels<Sink>();
+    case SACN_ORDER_GRB:
+      return SACNPixelLayout<TYPE, 1, 0, 2>::template kernels<Sink>();
+    case SACN_ORDER_GBR:
+      return SACNPixelLayout<TYPE, 2, 0, 1>::template kernels<Sink>();
+    case SACN_ORDER_BRG:
+      return SACNPixelLayout<TYPE, 1, 2, 0>::template kernels<Sink>();
+    case SACN_ORDER_BGR:
+      return SACNPixelLayout<TYPE, 2, 1, 0>::template kernels<Sink>();
+    case SACN_ORDER_RGB:
+    default:
+      return SACNPixelLayout<TYPE, 0, 1, 2>::template kernels<Sink>();
+  }
+}
+
+template<typename Sink>
+SACNPixelKernels<Sink> sacn_select_pixel_kernels(SACNChannelType type, SACNChannelOrder order) {
+  switch (type) {
+    case SACN_MONO:
+      return SACNPixelLayout<SACN_MONO, 0, 0, 0>::template kernels<Sink>();
+    case SACN_RGB:
+      return sacn_select_pixel_kernels<Sink, SACN_RGB>(order);
+    case SACN_RGBW:
+      return sacn_select_pixel_kernels<Sink, SACN_RGBW>(order);
+    case SACN_RGBWW:
+      return sacn_select_pixel_kernels<Sink, SACN_RGBWW>(order);
+    default:
+      return {};
+  }
+}
+
+}  // namespace sacn
+}  // namespace esphome
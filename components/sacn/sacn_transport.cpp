@@ -0,0 +1,281 @@
+#include "sacn_transport.h"
+#include "esphome/core/log.h"
+
+#ifdef USE_ARDUINO
+#include <lwip/igmp.h>
+#include <lwip/ip_addr.h>
+#ifdef USE_ESP32
+#include <lwip/tcpip.h>
+#endif
+#endif
+
+#ifdef USE_ESP32
+#include <lwip/sockets.h>
+#endif
+
+#ifdef USE_HOST
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#endif
+
+#if defined(USE_ESP32) || defined(USE_HOST)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+namespace esphome {
+namespace sacn {
+
+static const char *const TAG = "sacn_transport";
+
+std::unique_ptr<SACNTransport> make_transport(SACNReceiveBackend backend) {
+  switch (backend) {
+#ifdef USE_ARDUINO
+    case SACN_BACKEND_WIFI_UDP:
+      return make_unique<SACNWiFiUDPTransport>();
+#endif
+#if defined(USE_ESP32) || defined(USE_HOST)
+    case SACN_BACKEND_SOCKET:
+      return make_unique<SACNSocketTransport>();
+#endif
+#ifdef USE_HOST
+    case SACN_BACKEND_POSIX:
+      return make_unique<SACNPosixTransport>();
+#endif
+    default:
+      return nullptr;
+  }
+}
+
+#ifdef USE_ARDUINO
+
+bool SACNWiFiUDPTransport::begin(uint16_t port) { return this->udp_.begin(port); }
+
+void SACNWiFiUDPTransport::stop() { this->udp_.stop(); }
+
+uint16_t SACNWiFiUDPTransport::receive(uint8_t *buffer, uint16_t size) {
+  int packet_size = this->udp_.parsePacket();
+  if (packet_size <= 0) {
+    return 0;
+  }
+
+  // Whatever does not fit is discarded by the next parsePacket()
+  int len = this->udp_.read(buffer, std::min<int>(packet_size, size));
+  if (len <= 0) {
+    ESP_LOGW(TAG, "Failed to read UDP packet");
+    return 0;
+  }
+  return len;
+}
+
+uint32_t SACNWiFiUDPTransport::get_remote_ip() {
+  IPAddress remote = this->udp_.remoteIP();
+  const uint8_t octets[4] = {remote[0], remote[1], remote[2], remote[3]};
+  uint32_t ip;
+  memcpy(&ip, octets, sizeof(ip));
+  return ip;
+}
+
+// WiFiUDP has no per-socket membership; the interface joins the group and the socket
+// bound to any address receives its traffic.
+bool SACNWiFiUDPTransport::join_multicast(uint16_t universe) { return this->set_membership_(universe, true); }
+
+bool SACNWiFiUDPTransport::leave_multicast(uint16_t universe) { return this->set_membership_(universe, false); }
+
+#if defined(USE_ESP32) && !LWIP_TCPIP_CORE_LOCKING
+// A membership change handed to the lwIP task, which owns the raw API when core locking is off
+struct SACNIGMPRequest {
+  ip4_addr_t group;
+  bool join;
+};
+
+static void set_membership_in_tcpip_task(void *arg) {
+  auto *request = static_cast<SACNIGMPRequest *>(arg);
+  err_t err = request->join ? igmp_joingroup(IP4_ADDR_ANY4, &request->group)
+                            : igmp_leavegroup(IP4_ADDR_ANY4, &request->group);
+  if (err != ERR_OK) {
+    ESP_LOGW(TAG, "IGMP %s failed: %d", request->join ? "join" : "leave", (int) err);
+  }
+  delete request;
+}
+#endif
+
+bool SACNWiFiUDPTransport::set_membership_(uint16_t universe, bool join) {
+  ip4_addr_t group;
+  IP4_ADDR(&group, 239, 255, (universe >> 8) & 0xFF, universe & 0xFF);
+
+#if defined(USE_ESP32) && LWIP_TCPIP_CORE_LOCKING
+  // On ESP32 the lwIP core runs in its own task; its raw API is only safe while holding the core lock
+  LOCK_TCPIP_CORE();
+  err_t err = join ? igmp_joingroup(IP4_ADDR_ANY4, &group) : igmp_leavegroup(IP4_ADDR_ANY4, &group);
+  UNLOCK_TCPIP_CORE();
+  return err == ERR_OK;
+#elif defined(USE_ESP32)
+  // Without core locking the change is made in the lwIP task, which logs a failure itself
+  auto *request = new SACNIGMPRequest{group, join};
+  if (tcpip_callback(set_membership_in_tcpip_task, request) != ERR_OK) {
+    delete request;
+    return false;
+  }
+  return true;
+#else
+  // ESP8266 and LibreTiny: the raw API is called straight from the main loop. On ESP8266 lwIP runs in that
+  // context, LibreTiny's Arduino core calls lwIP from it in the same way.
+  return (join ? igmp_joingroup(IP4_ADDR_ANY4, &group) : igmp_leavegroup(IP4_ADDR_ANY4, &group)) == ERR_OK;
+#endif
+}
+
+#endif  // USE_ARDUINO
+
+#if defined(USE_ESP32) || defined(USE_HOST)
+
+bool SACNSocketTransport::begin(uint16_t port) {
+  this->stop();
+
+  this->fd_ = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (this->fd_ < 0) {
+    ESP_LOGE(TAG, "Could not create socket: errno %d", errno);
+    return false;
+  }
+
+  int enable = 1;
+  setsockopt(this->fd_, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+  int flags = fcntl(this->fd_, F_GETFL, 0);
+  if (flags < 0 || fcntl(this->fd_, F_SETFL, flags | O_NONBLOCK) < 0) {
+    ESP_LOGE(TAG, "Could not make socket non-blocking: errno %d", errno);
+    this->stop();
+    return false;
+  }
+
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(port);
+  if (bind(this->fd_, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0) {
+    ESP_LOGE(TAG, "Could not bind socket to port %d: errno %d", port, errno);
+    this->stop();
+    return false;
+  }
+
+  return true;
+}
+
+void SACNSocketTransport::stop() {
+  if (this->fd_ >= 0) {
+    close(this->fd_);
+    this->fd_ = -1;
+  }
+}
+
+uint16_t SACNSocketTransport::receive(uint8_t *buffer, uint16_t size) {
+  if (this->fd_ < 0) {
+    return 0;
+  }
+
+  // Datagrams larger than the buffer are truncated by the stack
+  struct sockaddr_in addr;
+  socklen_t addr_len = sizeof(addr);
+  ssize_t len = recvfrom(this->fd_, buffer, size, MSG_DONTWAIT, reinterpret_cast<struct sockaddr *>(&addr), &addr_len);
+  if (len <= 0) {
+    return 0;
+  }
+
+  this->remote_addr_ = addr.sin_addr.s_addr;
+  return len;
+}
+
+bool SACNSocketTransport::wait(uint32_t timeout_ms) {
+  int fd = this->fd_;
+  if (fd < 0) {
+    return false;
+  }
+
+  fd_set readfds;
+  FD_ZERO(&readfds);
+  FD_SET(fd, &readfds);
+  struct timeval tv;
+  tv.tv_sec = timeout_ms / 1000;
+  tv.tv_usec = (timeout_ms % 1000) * 1000;
+  return select(fd + 1, &readfds, nullptr, nullptr, &tv) > 0;
+}
+
+bool SACNSocketTransport::join_multicast(uint16_t universe) {
+  return this->set_membership_(universe, IP_ADD_MEMBERSHIP);
+}
+
+bool SACNSocketTransport::leave_multicast(uint16_t universe) {
+  return this->set_membership_(universe, IP_DROP_MEMBERSHIP);
+}
+
+bool SACNSocketTransport::set_membership_(uint16_t universe, int option) {
+  if (this->fd_ < 0) {
+    return false;
+  }
+
+  struct ip_mreq mreq;
+  memset(&mreq, 0, sizeof(mreq));
+  mreq.imr_multiaddr.s_addr = htonl((239UL << 24) | (255UL << 16) | universe);
+  mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+  return setsockopt(this->fd_, IPPROTO_IP, option, &mreq, sizeof(mreq)) == 0;
+}
+
+#endif  // USE_ESP32 || USE_HOST
+
+#ifdef USE_HOST
+
+uint16_t SACNPosixTransport::receive(uint8_t *buffer, uint16_t size) {
+#ifdef __linux__
+  if (this->batch_next_ >= this->batch_count_) {
+    if (this->fd_ < 0) {
+      return 0;
+    }
+
+    // Pull everything pending (up to a batch) with a single syscall
+    struct mmsghdr msgs[BATCH_SIZE];
+    struct iovec iovs[BATCH_SIZE];
+    struct sockaddr_in addrs[BATCH_SIZE];
+    memset(msgs, 0, sizeof(msgs));
+    for (uint8_t i = 0; i < BATCH_SIZE; i++) {
+      iovs[i].iov_base = this->batch_[i];
+      iovs[i].iov_len = SLOT_SIZE;
+      msgs[i].msg_hdr.msg_iov = &iovs[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+      msgs[i].msg_hdr.msg_name = &addrs[i];
+      msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+    }
+
+    int count = recvmmsg(this->fd_, msgs, BATCH_SIZE, MSG_DONTWAIT, nullptr);
+    if (count <= 0) {
+      return 0;
+    }
+
+    for (int i = 0; i < count; i++) {
+      this->batch_sizes_[i] = msgs[i].msg_len;
+      this->batch_addrs_[i] = addrs[i].sin_addr.s_addr;
+    }
+    this->batch_count_ = count;
+    this->batch_next_ = 0;
+  }
+
+  uint8_t slot = this->batch_next_++;
+  uint16_t len = std::min(size, this->batch_sizes_[slot]);
+  memcpy(buffer, this->batch_[slot], len);
+  this->remote_addr_ = this->batch_addrs_[slot];
+  return len;
+#else
+  return SACNSocketTransport::receive(buffer, size);
+#endif  // __linux__
+}
+
+#endif  // USE_HOST
+
+}  // namespace sacn
+}  // namespace esphome
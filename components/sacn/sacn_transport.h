@@ -0,0 +1,126 @@
+#pragma once
+
+#include "esphome/core/component.h"
+
+#ifdef USE_ARDUINO
+#ifdef USE_ESP32
+#include <WiFi.h>
+#endif
+
+#ifdef USE_ESP8266
+#include <ESP8266WiFi.h>
+#include <WiFiUdp.h>
+#endif
+
+#ifdef USE_LIBRETINY
+#include <WiFi.h>
+#include <WiFiUdp.h>
+#endif
+#endif  // USE_ARDUINO
+
+#include <memory>
+#include <string>
+
+namespace esphome {
+namespace sacn {
+
+enum SACNReceiveBackend {
+  SACN_BACKEND_WIFI_UDP = 0,  // Arduino WiFiUDP
+  SACN_BACKEND_SOCKET = 1,    // Non-blocking lwIP BSD socket (ESP32)
+  SACN_BACKEND_POSIX = 2      // Non-blocking POSIX socket (host)
+};
+
+// Source of sACN datagrams for SACNComponent
+class SACNTransport {
+ public:
+  virtual ~SACNTransport() = default;
+
+  virtual bool begin(uint16_t port) = 0;
+  virtual void stop() = 0;
+
+  // Copies the next pending datagram into buffer, truncated to size.
+  // Returns the number of bytes stored, or 0 if nothing is pending.
+  virtual uint16_t receive(uint8_t *buffer, uint16_t size) = 0;
+
+  // Blocks until a datagram is pending or the timeout expires. Only transports that can
+  // be read from another task than the main loop implement this.
+  virtual bool wait(uint32_t timeout_ms) { return false; }
+
+  // Sender of the last received datagram as an IPv4 address in network byte order. A receive task reads it right
+  // after receive(), as the next datagram replaces it.
+  virtual uint32_t get_remote_ip() = 0;
+
+  // Multicast group membership for 239.255.<universe high byte>.<universe low byte>
+  virtual bool join_multicast(uint16_t universe) = 0;
+  virtual bool leave_multicast(uint16_t universe) = 0;
+};
+
+// Returns nullptr if the backend is not available on this platform
+std::unique_ptr<SACNTransport> make_transport(SACNReceiveBackend backend);
+
+#ifdef USE_ARDUINO
+class SACNWiFiUDPTransport : public SACNTransport {
+ public:
+  bool begin(uint16_t port) override;
+  void stop() override;
+  uint16_t receive(uint8_t *buffer, uint16_t size) override;
+  uint32_t get_remote_ip() override;
+  bool join_multicast(uint16_t universe) override;
+  bool leave_multicast(uint16_t universe) override;
+
+ protected:
+  bool set_membership_(uint16_t universe, bool join);
+
+  WiFiUDP udp_;
+};
+#endif  // USE_ARDUINO
+
+#if defined(USE_ESP32) || defined(USE_HOST)
+// recvfrom() based transport, receiving straight into the caller's buffer.
+// lwIP provides the BSD socket API on ESP32, the host build uses the system's.
+class SACNSocketTransport : public SACNTransport {
+ public:
+  ~SACNSocketTransport() override { this->stop(); }
+
+  bool begin(uint16_t port) override;
+  void stop() override;
+  uint16_t receive(uint8_t *buffer, uint16_t size) override;
+  bool wait(uint32_t timeout_ms) override;
+  uint32_t get_remote_ip() override { return this->remote_addr_; }
+  bool join_multicast(uint16_t universe) override;
+  bool leave_multicast(uint16_t universe) override;
+
+ protected:
+  bool set_membership_(uint16_t universe, int option);
+
+  int fd_{-1};
+  uint32_t remote_addr_{0};  // Network byte order
+};
+#endif  // USE_ESP32 || USE_HOST
+
+#ifdef USE_HOST
+// Host transport for building and benchmarking the receive pipeline on a desktop.
+// Datagrams are fetched in batches with recvmmsg() where the OS provides it.
+class SACNPosixTransport : public SACNSocketTransport {
+ public:
+  void stop() override {
+    this->batch_count_ = 0;
+    this->batch_next_ = 0;
+    SACNSocketTransport::stop();
+  }
+  uint16_t receive(uint8_t *buffer, uint16_t size) override;
+
+ protected:
+  static const uint8_t BATCH_SIZE = 16;
+  static const uint16_t SLOT_SIZE = 1454;  // Largest DDP packet, E1.31 data packets take up to 638 bytes
+
+  uint8_t batch_[BATCH_SIZE][SLOT_SIZE];
+  uint16_t batch_sizes_[BATCH_SIZE];
+  uint32_t batch_addrs_[BATCH_SIZE];
+  uint8_t batch_count_{0};
+  uint8_t batch_next_{0};
+};
+#endif  // USE_HOST
+
+}  // namespace sacn
+}  // namespace esphome
@@ -0,0 +1,79 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    CONF_ID,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    STATE_CLASS_MEASUREMENT,
+    STATE_CLASS_TOTAL_INCREASING,
+    UNIT_MILLISECOND,
+)
+from . import CONF_SACN_ID, CONF_SACN_UNIVERSE, SACNComponent, SACNMetrics
+
+DEPENDENCIES = ["sacn"]
+
+CONF_PACKETS_RECEIVED = "packets_received"
+CONF_PACKETS_VALID = "packets_valid"
+CONF_PACKETS_DROPPED = "packets_dropped"
+CONF_SEQUENCE_GAPS = "sequence_gaps"
+CONF_FRAMES_APPLIED = "frames_applied"
+CONF_LOOP_TIME_AVG = "loop_time_avg"
+CONF_LOOP_TIME_MAX = "loop_time_max"
+CONF_JITTER = "jitter"
+
+COUNTERS = {
+    CONF_PACKETS_RECEIVED: "mdi:download-network",
+    CONF_PACKETS_VALID: "mdi:check-network",
+    CONF_PACKETS_DROPPED: "mdi:close-network",
+    CONF_SEQUENCE_GAPS: "mdi:numeric-off",
+    CONF_FRAMES_APPLIED: "mdi:led-strip-variant",
+}
+
+TIMINGS = {
+    CONF_LOOP_TIME_AVG: "mdi:timer-outline",
+    CONF_LOOP_TIME_MAX: "mdi:timer-alert-outline",
+    CONF_JITTER: "mdi:pulse",
+}
+
+CONFIG_SCHEMA = (
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(SACNMetrics),
+            cv.GenerateID(CONF_SACN_ID): cv.use_id(SACNComponent),
+            cv.Optional(CONF_SACN_UNIVERSE): cv.int_range(min=1, max=63999),
+            **{
+                cv.Optional(key): sensor.sensor_schema(
+                    icon=icon,
+                    accuracy_decimals=0,
+                    state_class=STATE_CLASS_TOTAL_INCREASING,
+                    entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+                )
+                for key, icon in COUNTERS.items()
+            },
+            **{
+                cv.Optional(key): sensor.sensor_schema(
+                    unit_of_measurement=UNIT_MILLISECOND,
+                    icon=icon,
+                    accuracy_decimals=2,
+                    state_class=STATE_CLASS_MEASUREMENT,
+                    entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+                )
+                for key, icon in TIMINGS.items()
+            },
+        }
+    ).extend(cv.polling_component_schema("60s"))
+)
+
+
+async def to_code(config):
+    parent = await cg.get_variable(config[CONF_SACN_ID])
+    var = cg.new_Pvariable(config[CONF_ID], parent)
+    await cg.register_component(var, config)
+
+    if CONF_SACN_UNIVERSE in config:
+        cg.add(var.set_universe(config[CONF_SACN_UNIVERSE]))
+
+    for key in (*COUNTERS, *TIMINGS):
+        if key in config:
+            sens = await sensor.new_sensor(config[key])
+            cg.add(getattr(var, f"set_{key}_sensor")(sens))
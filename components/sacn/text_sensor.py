@@ -0,0 +1,34 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import text_sensor
+from esphome.const import CONF_ID, ENTITY_CATEGORY_DIAGNOSTIC
+from . import CONF_SACN_ID, CONF_SACN_UNIVERSE, SACNComponent, SACNMetrics
+
+DEPENDENCIES = ["sacn"]
+
+CONF_DROP_REASONS = "drop_reasons"
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(SACNMetrics),
+        cv.GenerateID(CONF_SACN_ID): cv.use_id(SACNComponent),
+        cv.Optional(CONF_SACN_UNIVERSE): cv.int_range(min=1, max=63999),
+        cv.Optional(CONF_DROP_REASONS): text_sensor.text_sensor_schema(
+            icon="mdi:close-network",
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+    }
+).extend(cv.polling_component_schema("60s"))
+
+
+async def to_code(config):
+    parent = await cg.get_variable(config[CONF_SACN_ID])
+    var = cg.new_Pvariable(config[CONF_ID], parent)
+    await cg.register_component(var, config)
+
+    if CONF_SACN_UNIVERSE in config:
+        cg.add(var.set_universe(config[CONF_SACN_UNIVERSE]))
+
+    if CONF_DROP_REASONS in config:
+        sens = await text_sensor.new_text_sensor(config[CONF_DROP_REASONS])
+        cg.add(var.set_drop_reasons_text_sensor(sens))
@@ -0,0 +1,510 @@
+// Benchmarks of the sACN receive pipeline on the host: packet validation, dispatch to universes, conversion by
+// the effects, the pixel kernels and priority merging.
+//
+//   sacn_bench [--quick] [group...]
+//
+// Every row reports packets per second and nanoseconds per packet. Kernel and merge rows count one 512-channel
+// universe as a packet; convert rows count each universe received once, however many effects convert it.
+
+#include "host_support.h"
+#include "sacn.h"
+#include "sacn_addressable_light_effect.h"
+#include "sacn_light_effect.h"
+#include "sacn_merge.h"
+#include "sacn_pixel_kernels.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace esphome;
+using namespace esphome::sacn;
+using namespace esphome::sacn::testing;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+bool quick = false;
+std::vector<std::string> groups;  // Groups to run, all of them when empty
+volatile uint32_t result_sink;  // Keeps the results of pure functions alive
+
+const uint16_t SACN_PORT = 5568;
+const uint8_t BATCH_SIZE = 32;  // Packets handed to one loop(), as many as the WiFiUDP stand-in queues
+
+bool enabled(const char *group) {
+  if (groups.empty()) {
+    return true;
+  }
+  for (const auto &name : groups) {
+    if (name == group) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Times `body`, which handles `items` packets per call, until the figure is stable. `prepare` runs before every
+// call of `body` and is not timed.
+void run(const char *group, const std::string &name, uint32_t items, const std::function<void()> &prepare,
+         const std::function<void()> &body) {
+  if (!enabled(group)) {
+    return;
+  }
+
+  const Clock::duration min_time = quick ? std::chrono::milliseconds(1) : std::chrono::milliseconds(300);
+  prepare();
+  body();
+
+  Clock::duration spent{0};
+  uint64_t count = 0;
+  do {
+    prepare();
+    auto start = Clock::now();
+    body();
+    spent += Clock::now() - start;
+    count += items;
+  } while (spent < min_time);
+
+  double ns = std::chrono::duration<double, std::nano>(spent).count() / count;
+  printf("%-9s %-50s %12.0f packets/s %10.1f ns/packet\n", group, name.c_str(), 1e9 / ns, ns);
+}
+
+void run(const char *group, const std::string &name, uint32_t items, const std::function<void()> &body) {
+  run(group, name, items, [] {}, body);
+}
+
+const char *type_name(SACNChannelType type) {
+  switch (type) {
+    case SACN_MONO:
+      return "MONO";
+    case SACN_RGB:
+      return "RGB";
+    case SACN_RGBW:
+      return "RGBW";
+    default:
+      return "RGBWW";
+  }
+}
+
+// Sends data packets the way a console does, with new levels for every frame
+class Console {
+ public:
+  explicit Console(uint8_t source = 1, uint8_t priority = 100) {
+    this->options_.source = source;
+    this->options_.priority = priority;
+  }
+
+  void send(uint16_t universe, uint16_t count = E131View::MAX_SLOTS) {
+    uint8_t levels[E131View::MAX_SLOTS];
+    for (uint16_t i = 0; i < count; i++) {
+      levels[i] = i * 7 + this->frame_ * 3 + this->options_.source * 11;
+    }
+    this->options_.start_code = E131View::START_CODE_DMX;
+    this->send_(universe, levels, count);
+    this->frame_++;
+  }
+
+  // Per-address priorities: each source takes every other block of 8 channels
+  void send_priorities(uint16_t universe) {
+    uint8_t priorities[E131View::MAX_SLOTS];
+    for (uint16_t i = 0; i < E131View::MAX_SLOTS; i++) {
+      priorities[i] = (i / 8 + this->options_.source) % 2 == 0 ? 150 : 50;
+    }
+    this->options_.start_code = E131View::START_CODE_ADDRESS_PRIORITY;
+    this->send_(universe, priorities, E131View::MAX_SLOTS);
+  }
+
+ protected:
+  void send_(uint16_t universe, const uint8_t *levels, uint16_t count) {
+    uint8_t packet[638];
+    uint16_t size = make_e131_packet(packet, universe, levels, count, this->options_);
+    host_udp_send(SACN_PORT, packet, size);
+    this->options_.sequence++;
+  }
+
+  E131PacketOptions options_;
+  uint8_t frame_{0};
+};
+
+void bench_validate() {
+  uint8_t levels[E131View::MAX_SLOTS] = {};
+  uint8_t data[638];
+  uint16_t data_size = make_e131_packet(data, 1, levels, E131View::MAX_SLOTS);
+  uint8_t small[638];
+  uint16_t small_size = make_e131_packet(small, 1, levels, 64);
+  uint8_t sync[E131View::SYNC_PACKET_SIZE];
+  uint16_t sync_size = make_e131_sync_packet(sync, 1, 0);
+  uint8_t malformed[638];
+  memcpy(malformed, data, data_size);
+  malformed[10] ^= 0xFF;  // ACN packet identifier
+  uint8_t ddp[DDPView::MAX_PACKET_SIZE];
+  uint16_t ddp_size = make_ddp_packet(ddp, 0, levels, 480, true);
+
+  const uint32_t repeat = 1000;
+  run("validate", "E1.31 data, 512 slots", repeat, [&] {
+    for (uint32_t i = 0; i < repeat; i++) {
+      result_sink = E131View::parse(data, data_size).dmx_size();
+    }
+  });
+  run("validate", "E1.31 data, 64 slots", repeat, [&] {
+    for (uint32_t i = 0; i < repeat; i++) {
+      result_sink = E131View::parse(small, small_size).dmx_size();
+    }
+  });
+  run("validate", "E1.31 sync", repeat, [&] {
+    for (uint32_t i = 0; i < repeat; i++) {
+      result_sink = E131View::parse(sync, sync_size).sync_address();
+    }
+  });
+  run("validate", "E1.31 malformed", repeat, [&] {
+    for (uint32_t i = 0; i < repeat; i++) {
+      result_sink = E131View::parse(malformed, data_size).is_data();
+    }
+  });
+  run("validate", "DDP, 480 bytes", repeat, [&] {
+    for (uint32_t i = 0; i < repeat; i++) {
+      result_sink = DDPView::parse(ddp, ddp_size).data_size();
+    }
+  });
+}
+
+// Receive, validation, arbitration and the frame store, for one effect per universe
+void bench_dispatch(uint16_t universes) {
+  SACNComponent sacn;
+  std::vector<std::unique_ptr<CountingEffect>> effects;
+  for (uint16_t i = 0; i < universes; i++) {
+    effects.push_back(make_unique<CountingEffect>("Effect " + std::to_string(i)));
+    effects.back()->set_sacn(&sacn);
+    effects.back()->set_universe(1 + i);
+    effects.back()->start();
+  }
+
+  Console console;
+  uint16_t next = 0;
+  auto prepare = [&] {
+    for (uint8_t i = 0; i < BATCH_SIZE; i++) {
+      console.send(1 + next);
+      next = (next + 1) % universes;
+    }
+  };
+  auto body = [&] {
+    sacn.loop();
+    for (auto &effect : effects) {
+      effect->apply();
+    }
+  };
+  char name[64];
+  snprintf(name, sizeof(name), "E1.31, %d universe(s), 1 effect each", universes);
+  run("dispatch", name, BATCH_SIZE, prepare, body);
+
+  for (auto &effect : effects) {
+    effect->stop();
+  }
+}
+
+void bench_dispatch_unbound() {
+  SACNComponent sacn;
+  CountingEffect effect("Effect");
+  effect.set_sacn(&sacn);
+  effect.start();
+
+  Console console;
+  auto prepare = [&] {
+    for (uint8_t i = 0; i < BATCH_SIZE; i++) {
+      console.send(100);
+    }
+  };
+  run("dispatch", "E1.31, unbound universe", BATCH_SIZE, prepare, [&] { sacn.loop(); });
+  effect.stop();
+}
+
+// Universes it takes to cover `leds` pixels of the given type, starting at channel 1
+uint8_t universes_for(SACNChannelType type, int32_t leds) {
+  int32_t per_universe = E131View::MAX_SLOTS / type;
+  return (leds + per_universe - 1) / per_universe;
+}
+
+struct AddressableBenchOptions {
+  uint8_t pixel_group{1};
+  bool interpolation{false};
+  const char *variant{""};
+};
+
+// One or more strips, each driven by its own effect on the same universes
+void bench_addressable(SACNChannelType type, int32_t leds, uint8_t strips,
+                       const AddressableBenchOptions &options = AddressableBenchOptions()) {
+  SACNComponent sacn;
+  uint8_t universes = universes_for(type, (leds + options.pixel_group - 1) / options.pixel_group);
+  std::vector<std::unique_ptr<HostAddressableLight>> lights;
+  std::vector<std::unique_ptr<light::LightState>> states;
+  std::vector<std::unique_ptr<SACNAddressableLightEffect>> effects;
+  for (uint8_t i = 0; i < strips; i++) {
+    lights.push_back(make_unique<HostAddressableLight>(leds));
+    states.push_back(make_unique<light::LightState>("Strip " + std::to_string(i), lights.back().get()));
+    effects.push_back(make_unique<SACNAddressableLightEffect>("sACN"));
+    auto &effect = effects.back();
+    effect->init_internal(states.back().get());
+    effect->set_sacn(&sacn);
+    effect->set_universe(1);
+    effect->set_universe_count(universes);
+    effect->set_channel_type(type);
+    effect->set_pixel_group(options.pixel_group);
+    effect->set_interpolation(options.interpolation);
+    effect->start();
+  }
+
+  Console console;
+  auto prepare = [&] {
+    for (uint8_t i = 0; i < universes; i++) {
+      console.send(1 + i);
+    }
+    sacn.loop();
+  };
+  auto body = [&] {
+    for (uint8_t i = 0; i < strips; i++) {
+      effects[i]->apply(*lights[i], Color::WHITE);
+    }
+  };
+  char name[64];
+  snprintf(name, sizeof(name), "%s, %d LEDs, %d strip(s)%s", type_name(type), leds, strips, options.variant);
+  run("convert", name, universes, prepare, body);
+
+  for (auto &effect : effects) {
+    effect->stop();
+  }
+}
+
+// A DDP frame of `leds` RGB pixels, converted as its packets arrive
+void bench_ddp(int32_t leds) {
+  SACNComponent sacn;
+  HostAddressableLight light(leds);
+  light::LightState state("Strip", &light);
+  SACNAddressableLightEffect effect("DDP");
+  effect.init_internal(&state);
+  effect.set_sacn(&sacn);
+  effect.set_protocol(SACN_DDP);
+  effect.start();
+
+  uint8_t frame = 0;
+  uint32_t packets = (leds * 3 + DDPView::MAX_DATA_SIZE - 1) / DDPView::MAX_DATA_SIZE;
+  auto prepare = [&] {
+    uint8_t data[DDPView::MAX_DATA_SIZE];
+    uint8_t packet[DDPView::MAX_PACKET_SIZE];
+    memset(data, frame++, sizeof(data));
+    for (uint32_t offset = 0; offset < (uint32_t) leds * 3; offset += DDPView::MAX_DATA_SIZE) {
+      uint16_t size = std::min<uint32_t>(leds * 3 - offset, DDPView::MAX_DATA_SIZE);
+      host_udp_send(DDPView::PORT, packet, make_ddp_packet(packet, offset, data, size, offset + size >= leds * 3u));
+    }
+  };
+  char name[64];
+  snprintf(name, sizeof(name), "DDP RGB, %d LEDs", leds);
+  run("convert", name, packets, prepare, [&] { sacn.loop(); });
+  effect.stop();
+}
+
+void bench_light(SACNChannelType type, bool direct_output) {
+  SACNComponent sacn;
+  HostLightOutput output;
+  light::LightState state("Light", &output);
+  SACNLightEffect effect("sACN");
+  effect.init_internal(&state);
+  effect.set_sacn(&sacn);
+  effect.set_channel_type(type);
+  effect.set_direct_output(direct_output);
+  effect.start();
+
+  Console console;
+  auto prepare = [&] {
+    console.send(1, type);
+    sacn.loop();
+  };
+  char name[64];
+  snprintf(name, sizeof(name), "%s light, %s", type_name(type), direct_output ? "direct output" : "light call");
+  run("convert", name, 1, prepare, [&] { effect.apply(); });
+  effect.stop();
+}
+
+// The per-pixel switch the template kernels replaced, as a baseline
+void convert_switch(const uint8_t *payload, uint16_t num_pixels, SACNChannelType type, light::AddressableLight &it) {
+  uint16_t channels_per_pixel = type;
+  for (uint16_t p = 0; p < num_pixels; p++) {
+    uint16_t data_offset = p * channels_per_pixel;
+    auto output = it[p];
+    switch (type) {
+      case SACN_MONO: {
+        float brightness = payload[data_offset] / 255.0f;
+        output.set(Color(brightness * 255, brightness * 255, brightness * 255, 0));
+        break;
+      }
+      case SACN_RGB:
+        output.set(Color(payload[data_offset], payload[data_offset + 1], payload[data_offset + 2], 0));
+        break;
+      case SACN_RGBW:
+        output.set(Color(payload[data_offset], payload[data_offset + 1], payload[data_offset + 2],
+                         payload[data_offset + 3]));
+        break;
+      case SACN_RGBWW: {
+        output.set(Color(payload[data_offset], payload[data_offset + 1], payload[data_offset + 2], 0));
+        float cold_white = payload[data_offset + 3] / 255.0f;
+        float warm_white = payload[data_offset + 4] / 255.0f;
+        output.set_white(std::max(cold_white, warm_white) * 255);
+        break;
+      }
+    }
+  }
+}
+
+void bench_kernels() {
+  uint8_t data[E131View::MAX_SLOTS];
+  for (uint16_t i = 0; i < sizeof(data); i++) {
+    data[i] = i * 13;
+  }
+  HostAddressableLight light(E131View::MAX_SLOTS);
+  const uint32_t repeat = 100;
+
+  for (SACNChannelType type : {SACN_MONO, SACN_RGB, SACN_RGBW, SACN_RGBWW}) {
+    uint16_t pixels = E131View::MAX_SLOTS / type;
+    auto kernels = sacn_select_pixel_kernels<light::AddressableLight &>(type, SACN_ORDER_RGB);
+    std::string name = std::string(type_name(type)) + ", 512 channels";
+    run("kernels", name + ", template kernel", repeat, [&] {
+      for (uint32_t i = 0; i < repeat; i++) {
+        kernels.convert(data, pixels, light, 0);
+      }
+    });
+    run("kernels", name + ", per-pixel switch", repeat, [&] {
+      for (uint32_t i = 0; i < repeat; i++) {
+        convert_switch(data, pixels, type, light);
+      }
+    });
+  }
+
+  // Interpolation blends a whole strip of Color per frame
+  std::vector<Color> from(170), to(170), out(170);
+  for (size_t i = 0; i < to.size(); i++) {
+    to[i] = Color(i, i * 3, i * 5, i * 7);
+  }
+  run("kernels", "blend, 170 LEDs", repeat, [&] {
+    for (uint32_t i = 0; i < repeat; i++) {
+      sacn_blend_pixels(reinterpret_cast<const uint8_t *>(from.data()), reinterpret_cast<const uint8_t *>(to.data()),
+                        reinterpret_cast<uint8_t *>(out.data()), out.size() * sizeof(Color), i & 0xFF);
+    }
+  });
+}
+
+using MergeKernel = void (*)(uint8_t *, uint8_t *, const uint8_t *, const uint8_t *, size_t);
+
+// Per-address priority merging of a universe, `sources` sources with a level and a priority per channel each
+void bench_merge_kernel(const char *kernel_name, MergeKernel kernel, uint8_t sources) {
+  std::vector<std::vector<uint8_t>> levels(sources), priorities(sources);
+  for (uint8_t s = 0; s < sources; s++) {
+    levels[s].resize(E131View::MAX_SLOTS);
+    priorities[s].resize(E131View::MAX_SLOTS);
+    for (uint16_t i = 0; i < E131View::MAX_SLOTS; i++) {
+      levels[s][i] = i * 7 + s * 31;
+      priorities[s][i] = ((i / 8 + s) % 3) * 50;
+    }
+  }
+  uint8_t merged_levels[E131View::MAX_SLOTS];
+  uint8_t merged_priorities[E131View::MAX_SLOTS];
+  const uint32_t repeat = 100;
+
+  char name[64];
+  snprintf(name, sizeof(name), "merge kernel, %s, %d sources", kernel_name, sources);
+  run("merge", name, repeat, [&] {
+    for (uint32_t i = 0; i < repeat; i++) {
+      memset(merged_levels, 0, sizeof(merged_levels));
+      memset(merged_priorities, 0, sizeof(merged_priorities));
+      for (uint8_t s = 0; s < sources; s++) {
+        kernel(merged_levels, merged_priorities, levels[s].data(), priorities[s].data(), E131View::MAX_SLOTS);
+      }
+      result_sink = merged_levels[i % E131View::MAX_SLOTS];
+    }
+  });
+}
+
+enum MergeMode { MERGE_PRIORITY, MERGE_HTP, MERGE_PER_ADDRESS };
+
+// Two sources sending the same universe, through the whole receive path
+void bench_merge_sources(MergeMode mode) {
+  SACNComponent sacn;
+  sacn.set_htp_merge(mode == MERGE_HTP);
+  CountingEffect effect("Effect");
+  effect.set_sacn(&sacn);
+  effect.start();
+
+  Console first(1, 100);
+  Console second(2, mode == MERGE_PRIORITY ? 50 : 100);
+  auto prepare = [&] {
+    for (uint8_t i = 0; i < BATCH_SIZE / 4; i++) {
+      first.send(1);
+      second.send(1);
+      if (mode == MERGE_PER_ADDRESS) {
+        first.send_priorities(1);
+        second.send_priorities(1);
+      } else {
+        first.send(1);
+        second.send(1);
+      }
+    }
+  };
+  auto body = [&] {
+    sacn.loop();
+    effect.apply();
+  };
+  static const char *const NAMES[] = {"2 sources, highest priority only", "2 sources, HTP merge",
+                                      "2 sources, per-address priority"};
+  run("merge", NAMES[mode], BATCH_SIZE, prepare, body);
+  effect.stop();
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--quick") == 0) {
+      quick = true;
+    } else {
+      groups.push_back(argv[i]);
+    }
+  }
+
+  bench_validate();
+
+  bench_dispatch(1);
+  bench_dispatch(8);
+  bench_dispatch(32);
+  bench_dispatch_unbound();
+
+  for (SACNChannelType type : {SACN_MONO, SACN_RGB, SACN_RGBW, SACN_RGBWW}) {
+    for (int32_t leds : {50, 170, 680}) {
+      for (uint8_t strips : {1, 4}) {
+        bench_addressable(type, leds, strips);
+      }
+    }
+  }
+  bench_addressable(SACN_RGB, 680, 1, {2, false, ", grouped by 2"});
+  bench_addressable(SACN_RGB, 680, 1, {1, true, ", interpolated"});
+  bench_ddp(170);
+  bench_ddp(680);
+  for (SACNChannelType type : {SACN_MONO, SACN_RGB, SACN_RGBW, SACN_RGBWW}) {
+    bench_light(type, false);
+    bench_light(type, true);
+  }
+
+  bench_kernels();
+
+  for (uint8_t sources : {2, 4}) {
+    bench_merge_kernel("bytes", sacn_merge_priority_bytes, sources);
+    bench_merge_kernel("4 lanes", sacn_merge_priority, sources);
+  }
+  bench_merge_sources(MERGE_PRIORITY);
+  bench_merge_sources(MERGE_HTP);
+  bench_merge_sources(MERGE_PER_ADDRESS);
+
+  return 0;
+}
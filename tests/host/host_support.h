@@ -0,0 +1,173 @@
+#pragma once
+
+// Light outputs and packet builders shared by the host tests and benchmarks
+
+#include "esphome/components/light/addressable_light.h"
+#include "esphome/components/light/light_output.h"
+#include "esphome/components/light/light_state.h"
+#include "sacn_ddp.h"
+#include "sacn_e131.h"
+#include "sacn_light_effect_base.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace sacn {
+namespace testing {
+
+// An RGBW strip held in memory
+class HostAddressableLight : public light::AddressableLight {
+ public:
+  explicit HostAddressableLight(int32_t size) : buffer_(size * 4, 0) {}
+
+  int32_t size() const override { return this->buffer_.size() / 4; }
+  light::LightTraits get_traits() override {
+    light::LightTraits traits;
+    traits.add_supported_color_mode(light::ColorMode::RGB_WHITE);
+    return traits;
+  }
+  void write_state(light::LightState *state) override {}
+
+  Color get_led(int32_t index) const { return (*this)[index].get(); }
+
+ protected:
+  light::ESPColorView get_view_internal(int32_t index) const override {
+    uint8_t *led = const_cast<uint8_t *>(this->buffer_.data()) + index * 4;
+    return light::ESPColorView(led, led + 1, led + 2, led + 3);
+  }
+
+  std::vector<uint8_t> buffer_;
+};
+
+// A non-addressable light supporting every color mode, counting the writes it gets
+class HostLightOutput : public light::LightOutput {
+ public:
+  light::LightTraits get_traits() override {
+    light::LightTraits traits;
+    traits.add_supported_color_mode(light::ColorMode::BRIGHTNESS);
+    traits.add_supported_color_mode(light::ColorMode::RGB);
+    traits.add_supported_color_mode(light::ColorMode::RGB_WHITE);
+    traits.add_supported_color_mode(light::ColorMode::RGB_COLD_WARM_WHITE);
+    return traits;
+  }
+  void write_state(light::LightState *state) override { this->writes++; }
+
+  uint32_t writes{0};
+};
+
+// Counts the frames handed to it, for measuring or testing dispatch without any conversion
+class CountingEffect : public SACNLightEffectBase {
+ public:
+  explicit CountingEffect(const std::string &name) : name_(name) {}
+
+  const std::string &get_name() override { return this->name_; }
+  void apply() { this->pull_frames_(); }
+
+  uint32_t frames{0};
+  uint8_t first_level{0};  // Of the effect's first channel in the last frame
+
+ protected:
+  uint16_t process_(uint16_t universe, const uint8_t *payload, uint16_t size, uint16_t used) override {
+    this->frames++;
+    this->first_level = payload[0];
+    return size - used;
+  }
+
+  std::string name_;
+};
+
+// Fields of a generated E1.31 data packet besides its universe and levels
+struct E131PacketOptions {
+  uint8_t sequence{0};
+  uint8_t priority{100};
+  uint8_t start_code{E131View::START_CODE_DMX};
+  uint8_t options{0};
+  uint16_t sync_address{0};
+  uint16_t first_address{0};  // A range of the universe starting at this DMX channel, 0 for the whole universe
+  uint8_t source{1};  // Distinguishes the CID and name of the sending source
+};
+
+inline void write16(uint8_t *data, uint16_t value) {
+  data[0] = value >> 8;
+  data[1] = value & 0xFF;
+}
+
+inline void write_root_layer(uint8_t *packet, uint16_t size, uint8_t vector, uint8_t source) {
+  static const uint8_t ACN_PACKET_IDENTIFIER[12] = {0x41, 0x53, 0x43, 0x2d, 0x45, 0x31,
+                                                    0x2e, 0x31, 0x37, 0x00, 0x00, 0x00};
+  write16(packet, 0x0010);
+  write16(packet + 2, 0x0000);
+  memcpy(packet + 4, ACN_PACKET_IDENTIFIER, sizeof(ACN_PACKET_IDENTIFIER));
+  write16(packet + 16, 0x7000 | (size - 16));
+  memset(packet + 18, 0, 3);
+  packet[21] = vector;
+  for (uint8_t i = 0; i < 16; i++) {
+    packet[22 + i] = source * 16 + i;
+  }
+}
+
+// Writes a data packet carrying `count` levels into `packet`, which must hold 638 bytes, and returns its size
+inline uint16_t make_e131_packet(uint8_t *packet, uint16_t universe, const uint8_t *levels, uint16_t count,
+                                 const E131PacketOptions &options = E131PacketOptions()) {
+  // A range of the universe carries no start code
+  bool range = options.first_address != 0;
+  uint16_t size = E131View::HEADER_SIZE - (range ? 1 : 0) + count;
+  memset(packet, 0, E131View::HEADER_SIZE);
+  write_root_layer(packet, size, 0x04, options.source);
+
+  write16(packet + 38, 0x7000 | (size - 38));
+  packet[43] = 0x02;
+  snprintf(reinterpret_cast<char *>(packet + 44), 64, "Host source %d", options.source);
+  packet[108] = options.priority;
+  write16(packet + 109, options.sync_address);
+  packet[111] = options.sequence;
+  packet[112] = options.options;
+  write16(packet + 113, universe);
+
+  write16(packet + 115, 0x7000 | (size - 115));
+  packet[117] = 0x02;
+  packet[118] = 0xA1;
+  write16(packet + 119, options.first_address);
+  write16(packet + 121, 0x0001);
+  write16(packet + 123, range ? count : count + 1);
+  if (!range) {
+    packet[125] = options.start_code;
+  }
+  memcpy(packet + size - count, levels, count);
+  return size;
+}
+
+// Writes a universe synchronization packet into `packet` and returns its size
+inline uint16_t make_e131_sync_packet(uint8_t *packet, uint16_t sync_address, uint8_t sequence, uint8_t source = 1) {
+  uint16_t size = E131View::SYNC_PACKET_SIZE;
+  memset(packet, 0, size);
+  write_root_layer(packet, size, 0x08, source);
+  write16(packet + 38, 0x7000 | (size - 38));
+  packet[43] = 0x01;
+  packet[44] = sequence;
+  write16(packet + 45, sync_address);
+  return size;
+}
+
+// Writes a DDP packet carrying `size` bytes at `offset` into `packet` and returns its size
+inline uint16_t make_ddp_packet(uint8_t *packet, uint32_t offset, const uint8_t *data, uint16_t size, bool push,
+                                uint8_t sequence = 0) {
+  packet[0] = DDPView::VERSION_1 | (push ? DDPView::FLAG_PUSH : 0);
+  packet[1] = sequence & 0x0F;
+  packet[2] = 0x0B;  // RGB, 8 bits per channel
+  packet[3] = DDPView::ID_DISPLAY;
+  packet[4] = offset >> 24;
+  packet[5] = (offset >> 16) & 0xFF;
+  packet[6] = (offset >> 8) & 0xFF;
+  packet[7] = offset & 0xFF;
+  write16(packet + 8, size);
+  memcpy(packet + DDPView::HEADER_SIZE, data, size);
+  return DDPView::HEADER_SIZE + size;
+}
+
+}  // namespace testing
+}  // namespace sacn
+}  // namespace esphome
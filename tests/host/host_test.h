@@ -0,0 +1,37 @@
+#pragma once
+
+// Minimal checks for the host tests. Failed checks are reported and counted, and main() returns
+// testing::test_result() so ctest sees them.
+
+#include <cstdio>
+
+namespace esphome {
+namespace sacn {
+namespace testing {
+
+inline unsigned check_failures = 0;
+
+inline bool check(bool condition, const char *expression, const char *file, int line) {
+  if (!condition) {
+    // A fuzz run can fail the same check many times over, the first ones tell what broke
+    if (check_failures < 20) {
+      fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+    }
+    check_failures++;
+  }
+  return condition;
+}
+
+inline int test_result() {
+  if (check_failures > 0) {
+    fprintf(stderr, "%u check(s) failed\n", check_failures);
+    return 1;
+  }
+  return 0;
+}
+
+}  // namespace testing
+}  // namespace sacn
+}  // namespace esphome
+
+#define SACN_CHECK(condition) ::esphome::sacn::testing::check((condition), #condition, __FILE__, __LINE__)
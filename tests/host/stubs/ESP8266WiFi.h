@@ -0,0 +1,4 @@
+#pragma once
+
+// Host stand-in for the ESP8266 Arduino WiFi header; the sACN component only needs WiFiUdp.h
+#include "WiFiUdp.h"
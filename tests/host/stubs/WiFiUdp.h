@@ -0,0 +1,70 @@
+#pragma once
+
+// Host stand-in for the Arduino WiFiUDP class. Datagrams are handed over in memory with host_udp_send() instead of
+// through a socket, so tests and benchmarks need no network and measure none of its cost.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+class IPAddress {
+ public:
+  IPAddress() = default;
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : octets_{a, b, c, d} {}
+
+  uint8_t operator[](int index) const { return this->octets_[index]; }
+
+ protected:
+  uint8_t octets_[4]{0, 0, 0, 0};
+};
+
+class WiFiUDP {
+ public:
+  WiFiUDP() = default;
+  WiFiUDP(const WiFiUDP &) = delete;
+  WiFiUDP &operator=(const WiFiUDP &) = delete;
+  ~WiFiUDP() { this->stop(); }
+
+  uint8_t begin(uint16_t port);
+  void stop();
+
+  // Moves on to the next datagram, dropping what is left of the current one. Returns its size, or 0 if none.
+  int parsePacket();
+  int available() const { return this->current_size_ - this->read_pos_; }
+  int read(uint8_t *buffer, size_t len);
+
+  IPAddress remoteIP() const { return this->remote_; }
+  uint16_t remotePort() const { return 5568; }
+
+ protected:
+  friend size_t host_udp_send(uint16_t port, const uint8_t *data, size_t size, IPAddress from);
+
+  // Datagrams waiting to be read; further ones are dropped, as by a full socket buffer
+  static const uint8_t QUEUE_SIZE = 32;
+  static const uint16_t MAX_DATAGRAM_SIZE = 1472;
+  struct Datagram {
+    uint8_t data[MAX_DATAGRAM_SIZE];
+    uint16_t size;
+    IPAddress from;
+  };
+
+  bool push_(const uint8_t *data, size_t size, IPAddress from);
+
+  uint16_t port_{0};  // 0 while not listening
+  std::unique_ptr<Datagram[]> queue_;
+  uint8_t head_{0};  // The datagram being read, once parsePacket() returned it
+  uint8_t count_{0};
+  bool parsed_{false};
+  uint16_t current_size_{0};
+  uint16_t read_pos_{0};
+  IPAddress remote_;
+};
+
+// Host only: delivers a datagram to every WiFiUDP listening on `port`, truncated to the largest UDP payload over
+// WiFi. Returns the number of receivers that queued it.
+size_t host_udp_send(uint16_t port, const uint8_t *data, size_t size, IPAddress from = IPAddress(10, 0, 0, 1));
+
+// Host only: host_udp_send() addressed to `to`. Datagrams to a multicast group are dropped unless the group was
+// joined through IGMP, as by the network interface.
+size_t host_udp_send_to(IPAddress to, uint16_t port, const uint8_t *data, size_t size,
+                        IPAddress from = IPAddress(10, 0, 0, 1));
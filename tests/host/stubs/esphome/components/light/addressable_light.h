@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+
+#include "esphome/core/component.h"
+#include "light_output.h"
+#include "light_state.h"
+
+namespace esphome {
+
+struct Color {
+  union {
+    struct {
+      union {
+        uint8_t r;
+        uint8_t red;
+      };
+      union {
+        uint8_t g;
+        uint8_t green;
+      };
+      union {
+        uint8_t b;
+        uint8_t blue;
+      };
+      union {
+        uint8_t w;
+        uint8_t white;
+      };
+    };
+    uint8_t raw[4];
+    uint32_t raw_32;
+  };
+
+  constexpr Color() : raw_32(0) {}
+  constexpr Color(uint8_t red, uint8_t green, uint8_t blue, uint8_t white = 0) : r(red), g(green), b(blue), w(white) {}
+
+  bool operator==(const Color &rhs) const { return this->raw_32 == rhs.raw_32; }
+  bool operator!=(const Color &rhs) const { return this->raw_32 != rhs.raw_32; }
+
+  static const Color BLACK;
+  static const Color WHITE;
+};
+
+inline const Color Color::BLACK(0, 0, 0, 0);
+inline const Color Color::WHITE(255, 255, 255, 255);
+
+namespace light {
+
+// Writes one LED of the strip's buffer; the stand-in skips color correction
+class ESPColorView {
+ public:
+  ESPColorView(uint8_t *red, uint8_t *green, uint8_t *blue, uint8_t *white)
+      : red_(red), green_(green), blue_(blue), white_(white) {}
+
+  void set(const Color &color) { this->set_rgbw(color.r, color.g, color.b, color.w); }
+  void set_red(uint8_t red) { *this->red_ = red; }
+  void set_green(uint8_t green) { *this->green_ = green; }
+  void set_blue(uint8_t blue) { *this->blue_ = blue; }
+  void set_white(uint8_t white) {
+    if (this->white_ != nullptr) {
+      *this->white_ = white;
+    }
+  }
+  void set_rgb(uint8_t red, uint8_t green, uint8_t blue) {
+    this->set_red(red);
+    this->set_green(green);
+    this->set_blue(blue);
+  }
+  void set_rgbw(uint8_t red, uint8_t green, uint8_t blue, uint8_t white) {
+    this->set_rgb(red, green, blue);
+    this->set_white(white);
+  }
+  Color get() const {
+    return Color(*this->red_, *this->green_, *this->blue_, this->white_ != nullptr ? *this->white_ : 0);
+  }
+
+ protected:
+  uint8_t *const red_;
+  uint8_t *const green_;
+  uint8_t *const blue_;
+  uint8_t *const white_;
+};
+
+class AddressableLight : public LightOutput, public Component {
+ public:
+  virtual int32_t size() const = 0;
+
+  ESPColorView operator[](int32_t index) const { return this->get_view_internal(this->interpret_index(index)); }
+  ESPColorView get(int32_t index) { return this->get_view_internal(this->interpret_index(index)); }
+
+  void schedule_show() { this->show_count_++; }
+  void set_effect_active(bool effect_active) { this->effect_active_ = effect_active; }
+  bool is_effect_active() const { return this->effect_active_; }
+
+  // Number of schedule_show() calls, for tests and benchmarks
+  uint32_t get_show_count() const { return this->show_count_; }
+
+ protected:
+  int32_t interpret_index(int32_t index) const { return index < 0 ? index + this->size() : index; }
+  virtual ESPColorView get_view_internal(int32_t index) const = 0;
+
+  bool effect_active_{false};
+  uint32_t show_count_{0};
+};
+
+}  // namespace light
+}  // namespace esphome
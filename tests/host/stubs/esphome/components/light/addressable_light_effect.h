@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string>
+
+#include "addressable_light.h"
+#include "light_effect.h"
+#include "light_state.h"
+
+namespace esphome {
+namespace light {
+
+class AddressableLightEffect : public LightEffect {
+ public:
+  explicit AddressableLightEffect(const std::string &name) : LightEffect(name) {}
+
+  void start_internal() override { this->start(); }
+  virtual void apply(AddressableLight &it, const Color &current_color) = 0;
+  void apply() override { this->apply(*this->get_addressable_(), Color::WHITE); }
+
+ protected:
+  AddressableLight *get_addressable_() const { return static_cast<AddressableLight *>(this->state_->get_output()); }
+};
+
+}  // namespace light
+}  // namespace esphome
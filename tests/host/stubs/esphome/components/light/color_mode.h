@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+namespace esphome {
+namespace light {
+
+enum class ColorMode : uint8_t {
+  UNKNOWN,
+  ON_OFF,
+  BRIGHTNESS,
+  WHITE,
+  COLOR_TEMPERATURE,
+  COLD_WARM_WHITE,
+  RGB,
+  RGB_WHITE,
+  RGB_COLOR_TEMPERATURE,
+  RGB_COLD_WARM_WHITE,
+};
+
+}  // namespace light
+}  // namespace esphome
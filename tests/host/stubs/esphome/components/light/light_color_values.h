@@ -0,0 +1,46 @@
+#pragma once
+
+#include "color_mode.h"
+
+namespace esphome {
+namespace light {
+
+class LightColorValues {
+ public:
+  ColorMode get_color_mode() const { return this->color_mode_; }
+  void set_color_mode(ColorMode color_mode) { this->color_mode_ = color_mode; }
+  float get_state() const { return this->state_; }
+  void set_state(float state) { this->state_ = state; }
+  void set_state(bool state) { this->state_ = state ? 1.0f : 0.0f; }
+  float get_brightness() const { return this->brightness_; }
+  void set_brightness(float brightness) { this->brightness_ = brightness; }
+  float get_color_brightness() const { return this->color_brightness_; }
+  void set_color_brightness(float color_brightness) { this->color_brightness_ = color_brightness; }
+  float get_red() const { return this->red_; }
+  void set_red(float red) { this->red_ = red; }
+  float get_green() const { return this->green_; }
+  void set_green(float green) { this->green_ = green; }
+  float get_blue() const { return this->blue_; }
+  void set_blue(float blue) { this->blue_ = blue; }
+  float get_white() const { return this->white_; }
+  void set_white(float white) { this->white_ = white; }
+  float get_cold_white() const { return this->cold_white_; }
+  void set_cold_white(float cold_white) { this->cold_white_ = cold_white; }
+  float get_warm_white() const { return this->warm_white_; }
+  void set_warm_white(float warm_white) { this->warm_white_ = warm_white; }
+
+ protected:
+  ColorMode color_mode_{ColorMode::UNKNOWN};
+  float state_{0.0f};
+  float brightness_{1.0f};
+  float color_brightness_{1.0f};
+  float red_{1.0f};
+  float green_{1.0f};
+  float blue_{1.0f};
+  float white_{1.0f};
+  float cold_white_{1.0f};
+  float warm_white_{1.0f};
+};
+
+}  // namespace light
+}  // namespace esphome
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+
+#include "esphome/core/component.h"
+
+namespace esphome {
+namespace light {
+
+class LightState;
+
+class LightEffect {
+ public:
+  explicit LightEffect(const std::string &name) : name_(name) {}
+  virtual ~LightEffect() = default;
+
+  virtual void start() {}
+  virtual void start_internal() { this->start(); }
+  virtual void stop() {}
+  virtual void apply() = 0;
+
+  const std::string &get_name() { return this->name_; }
+
+  virtual void init() {}
+  void init_internal(LightState *state) {
+    this->state_ = state;
+    this->init();
+  }
+
+ protected:
+  LightState *state_{nullptr};
+  std::string name_;
+};
+
+}  // namespace light
+}  // namespace esphome
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "light_state.h"
+#include "light_traits.h"
+
+namespace esphome {
+namespace light {
+
+class LightOutput {
+ public:
+  virtual ~LightOutput() = default;
+
+  virtual LightTraits get_traits() = 0;
+  virtual void write_state(LightState *state) = 0;
+};
+
+inline LightTraits LightState::get_traits() { return this->output_->get_traits(); }
+
+}  // namespace light
+}  // namespace esphome
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "esphome/core/component.h"
+#include "light_color_values.h"
+#include "light_traits.h"
+
+namespace esphome {
+namespace light {
+
+class LightOutput;
+class LightState;
+
+// Collects the requested values and stores them in the state on perform(); no transitions or validation
+class LightCall {
+ public:
+  explicit LightCall(LightState *parent);
+
+  LightCall &set_state(bool state) {
+    this->values_.set_state(state);
+    return *this;
+  }
+  LightCall &set_color_mode(ColorMode color_mode) {
+    this->values_.set_color_mode(color_mode);
+    return *this;
+  }
+  LightCall &set_color_mode_if_supported(ColorMode color_mode) { return this->set_color_mode(color_mode); }
+  LightCall &set_transition_length(uint32_t transition_length) { return *this; }
+  LightCall &set_publish(bool publish) { return *this; }
+  LightCall &set_save(bool save) { return *this; }
+
+#define SACN_HOST_LIGHT_CALL_FIELD(field) \
+  LightCall &set_##field(float field) { \
+    this->values_.set_##field(field); \
+    return *this; \
+  } \
+  LightCall &set_##field##_if_supported(float field) { return this->set_##field(field); }
+  SACN_HOST_LIGHT_CALL_FIELD(brightness)
+  SACN_HOST_LIGHT_CALL_FIELD(color_brightness)
+  SACN_HOST_LIGHT_CALL_FIELD(red)
+  SACN_HOST_LIGHT_CALL_FIELD(green)
+  SACN_HOST_LIGHT_CALL_FIELD(blue)
+  SACN_HOST_LIGHT_CALL_FIELD(white)
+  SACN_HOST_LIGHT_CALL_FIELD(cold_white)
+  SACN_HOST_LIGHT_CALL_FIELD(warm_white)
+#undef SACN_HOST_LIGHT_CALL_FIELD
+
+  void perform();
+
+ protected:
+  LightState *parent_;
+  LightColorValues values_;
+};
+
+class LightState : public Component {
+ public:
+  LightState(const std::string &name, LightOutput *output) : name_(name), output_(output) {}
+
+  const std::string &get_name() const { return this->name_; }
+  LightOutput *get_output() const { return this->output_; }
+  LightTraits get_traits();
+
+  LightCall make_call() { return LightCall(this); }
+  LightCall turn_on() { return this->make_call().set_state(true); }
+  LightCall turn_off() { return this->make_call().set_state(false); }
+
+  void publish_state() {}
+
+  // Number of light calls performed, for tests
+  uint32_t get_call_count() const { return this->call_count_; }
+
+  LightColorValues remote_values;
+  LightColorValues current_values;
+
+ protected:
+  friend LightCall;
+
+  std::string name_;
+  LightOutput *output_;
+  uint32_t call_count_{0};
+};
+
+inline LightCall::LightCall(LightState *parent) : parent_(parent), values_(parent->remote_values) {}
+
+inline void LightCall::perform() {
+  this->parent_->remote_values = this->values_;
+  this->parent_->current_values = this->values_;
+  this->parent_->call_count_++;
+}
+
+}  // namespace light
+}  // namespace esphome
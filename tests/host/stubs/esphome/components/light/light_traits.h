@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+#include "color_mode.h"
+
+namespace esphome {
+namespace light {
+
+class LightTraits {
+ public:
+  void add_supported_color_mode(ColorMode color_mode) { this->color_modes_ |= 1u << static_cast<uint8_t>(color_mode); }
+  bool supports_color_mode(ColorMode color_mode) const {
+    return this->color_modes_ & (1u << static_cast<uint8_t>(color_mode));
+  }
+
+ protected:
+  uint32_t color_modes_{0};
+};
+
+}  // namespace light
+}  // namespace esphome
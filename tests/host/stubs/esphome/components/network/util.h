@@ -0,0 +1,14 @@
+#pragma once
+
+namespace esphome {
+namespace network {
+
+// Host stand-in for the network component: connected unless a test says otherwise
+bool is_connected();
+
+}  // namespace network
+
+// Host only: takes the network down or brings it back, as on a WiFi disconnect and reconnect
+void host_set_network_connected(bool connected);
+
+}  // namespace esphome
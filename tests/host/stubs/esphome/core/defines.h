@@ -0,0 +1,3 @@
+#pragma once
+
+// Generated from the YAML configuration in a real build; the host target passes its defines on the command line
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+namespace esphome {
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+
+// Host only: moves millis() and micros() forward, for tests of timeouts without waiting for them
+void host_advance_time(uint32_t ms);
+
+}  // namespace esphome
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace esphome {
+
+using std::make_unique;
+
+}  // namespace esphome
@@ -0,0 +1,37 @@
+#pragma once
+
+// Host stand-in for esphome/core/log.h. Verbose levels are compiled out as in a firmware built at the default
+// DEBUG level, the others are printed to stderr when at or above the level set with host_set_log_level().
+
+#define ESPHOME_LOG_LEVEL_NONE 0
+#define ESPHOME_LOG_LEVEL_ERROR 1
+#define ESPHOME_LOG_LEVEL_WARN 2
+#define ESPHOME_LOG_LEVEL_INFO 3
+#define ESPHOME_LOG_LEVEL_CONFIG 4
+#define ESPHOME_LOG_LEVEL_DEBUG 5
+#define ESPHOME_LOG_LEVEL_VERBOSE 6
+#define ESPHOME_LOG_LEVEL_VERY_VERBOSE 7
+
+namespace esphome {
+
+void host_log(int level, const char *tag, const char *format, ...) __attribute__((format(printf, 3, 4)));
+// Messages above this level are dropped, ESPHOME_LOG_LEVEL_WARN unless changed
+void host_set_log_level(int level);
+
+}  // namespace esphome
+
+#define ESP_LOGE(tag, ...) ::esphome::host_log(ESPHOME_LOG_LEVEL_ERROR, tag, __VA_ARGS__)
+#define ESP_LOGW(tag, ...) ::esphome::host_log(ESPHOME_LOG_LEVEL_WARN, tag, __VA_ARGS__)
+#define ESP_LOGI(tag, ...) ::esphome::host_log(ESPHOME_LOG_LEVEL_INFO, tag, __VA_ARGS__)
+#define ESP_LOGCONFIG(tag, ...) ::esphome::host_log(ESPHOME_LOG_LEVEL_CONFIG, tag, __VA_ARGS__)
+#define ESP_LOGD(tag, ...) ::esphome::host_log(ESPHOME_LOG_LEVEL_DEBUG, tag, __VA_ARGS__)
+#define ESP_LOGV(tag, ...) \
+  do { \
+  } while (0)
+#define ESP_LOGVV(tag, ...) \
+  do { \
+  } while (0)
+
+#define YESNO(b) ((b) ? "YES" : "NO")
+#define LOG_UPDATE_INTERVAL(this) \
+  ESP_LOGCONFIG(TAG, "  Update Interval: %.1fs", (this)->get_update_interval() / 1000.0f)
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "lwip/ip_addr.h"
+
+#include <cstddef>
+
+// Host stand-in for lwIP's IGMP API, keeping the set of joined groups in memory
+err_t igmp_joingroup(const ip4_addr_t *ifaddr, const ip4_addr_t *groupaddr);
+err_t igmp_leavegroup(const ip4_addr_t *ifaddr, const ip4_addr_t *groupaddr);
+
+// Host only: whether the interface is a member of `group`, and how many groups it joined
+bool host_igmp_is_member(const ip4_addr_t *group);
+size_t host_igmp_group_count();
+// Host only: join and leave requests made so far, successful or not
+uint32_t host_igmp_requests();
+// Host only: makes joins fail with ERR_MEM, as lwIP does once its group table is full
+void host_igmp_set_full(bool full);
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+#include "lwip/err.h"
+
+struct ip4_addr_t {
+  uint32_t addr;  // Network byte order
+};
+typedef ip4_addr_t ip_addr_t;
+
+#define IP4_ADDR(ipaddr, a, b, c, d) \
+  (ipaddr)->addr = (((uint32_t) (d) & 0xFF) << 24) | (((uint32_t) (c) & 0xFF) << 16) | \
+                   (((uint32_t) (b) & 0xFF) << 8) | ((uint32_t) (a) & 0xFF)
+
+extern const ip4_addr_t ip_addr_any;
+#define IP4_ADDR_ANY4 (&ip_addr_any)
@@ -0,0 +1,183 @@
+// Implementations behind the host stand-in headers
+
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+#include "esphome/components/network/util.h"
+#include "lwip/igmp.h"
+#include "WiFiUdp.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace esphome {
+
+static const auto START = std::chrono::steady_clock::now();
+static uint64_t time_offset_us = 0;  // Added by host_advance_time()
+
+static uint64_t now_us() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - START).count() +
+         time_offset_us;
+}
+
+uint32_t millis() { return now_us() / 1000; }
+uint32_t micros() { return now_us(); }
+void delay(uint32_t ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+void host_advance_time(uint32_t ms) { time_offset_us += ms * 1000ULL; }
+
+static int log_level = ESPHOME_LOG_LEVEL_WARN;
+
+void host_set_log_level(int level) { log_level = level; }
+
+void host_log(int level, const char *tag, const char *format, ...) {
+  if (level > log_level) {
+    return;
+  }
+  static const char LETTERS[] = "-EWICDV";
+  fprintf(stderr, "[%c][%s]: ", LETTERS[level], tag);
+  va_list args;
+  va_start(args, format);
+  vfprintf(stderr, format, args);
+  va_end(args);
+  fputc('\n', stderr);
+}
+
+}  // namespace esphome
+
+const ip4_addr_t ip_addr_any = {0};
+
+static std::set<uint32_t> igmp_groups;
+static uint32_t igmp_requests = 0;
+static bool igmp_full = false;
+
+err_t igmp_joingroup(const ip4_addr_t *ifaddr, const ip4_addr_t *groupaddr) {
+  igmp_requests++;
+  // With the interface down there is no netif to join on
+  if (!esphome::network::is_connected()) {
+    return ERR_VAL;
+  }
+  if (igmp_full && !igmp_groups.count(groupaddr->addr)) {
+    return ERR_MEM;
+  }
+  igmp_groups.insert(groupaddr->addr);
+  return ERR_OK;
+}
+
+err_t igmp_leavegroup(const ip4_addr_t *ifaddr, const ip4_addr_t *groupaddr) {
+  igmp_requests++;
+  // lwIP rejects leaving a group that was never joined
+  return igmp_groups.erase(groupaddr->addr) > 0 ? ERR_OK : ERR_VAL;
+}
+
+bool host_igmp_is_member(const ip4_addr_t *group) { return igmp_groups.count(group->addr) > 0; }
+size_t host_igmp_group_count() { return igmp_groups.size(); }
+uint32_t host_igmp_requests() { return igmp_requests; }
+void host_igmp_set_full(bool full) { igmp_full = full; }
+
+namespace esphome {
+
+static bool network_connected = true;
+
+bool network::is_connected() { return network_connected; }
+
+// The interface drops its group memberships when it goes down
+void host_set_network_connected(bool connected) {
+  network_connected = connected;
+  if (!connected) {
+    igmp_groups.clear();
+  }
+}
+
+}  // namespace esphome
+
+static std::vector<WiFiUDP *> listeners;
+
+uint8_t WiFiUDP::begin(uint16_t port) {
+  this->stop();
+  if (!this->queue_) {
+    this->queue_.reset(new Datagram[QUEUE_SIZE]);
+  }
+  this->port_ = port;
+  listeners.push_back(this);
+  return 1;
+}
+
+void WiFiUDP::stop() {
+  if (this->port_ == 0) {
+    return;
+  }
+  listeners.erase(std::find(listeners.begin(), listeners.end(), this));
+  this->port_ = 0;
+  this->count_ = 0;
+  this->parsed_ = false;
+  this->current_size_ = 0;
+  this->read_pos_ = 0;
+}
+
+int WiFiUDP::parsePacket() {
+  if (this->parsed_) {
+    this->head_ = (this->head_ + 1) % QUEUE_SIZE;
+    this->count_--;
+    this->parsed_ = false;
+  }
+  this->current_size_ = 0;
+  this->read_pos_ = 0;
+  if (this->count_ == 0) {
+    return 0;
+  }
+
+  const Datagram &datagram = this->queue_[this->head_];
+  this->parsed_ = true;
+  this->current_size_ = datagram.size;
+  this->remote_ = datagram.from;
+  return datagram.size;
+}
+
+int WiFiUDP::read(uint8_t *buffer, size_t len) {
+  if (!this->parsed_) {
+    return -1;
+  }
+  size_t count = std::min<size_t>(len, this->available());
+  memcpy(buffer, this->queue_[this->head_].data + this->read_pos_, count);
+  this->read_pos_ += count;
+  return count;
+}
+
+bool WiFiUDP::push_(const uint8_t *data, size_t size, IPAddress from) {
+  if (this->count_ == QUEUE_SIZE) {
+    return false;
+  }
+  Datagram &datagram = this->queue_[(this->head_ + this->count_) % QUEUE_SIZE];
+  datagram.size = std::min<size_t>(size, MAX_DATAGRAM_SIZE);
+  memcpy(datagram.data, data, datagram.size);
+  datagram.from = from;
+  this->count_++;
+  return true;
+}
+
+size_t host_udp_send(uint16_t port, const uint8_t *data, size_t size, IPAddress from) {
+  size_t received = 0;
+  for (auto *udp : listeners) {
+    if (udp->port_ == port && udp->push_(data, size, from)) {
+      received++;
+    }
+  }
+  return received;
+}
+
+size_t host_udp_send_to(IPAddress to, uint16_t port, const uint8_t *data, size_t size, IPAddress from) {
+  // Multicast only reaches the interface while it is a member of the group
+  if (to[0] >= 224 && to[0] <= 239) {
+    ip4_addr_t group;
+    IP4_ADDR(&group, to[0], to[1], to[2], to[3]);
+    if (!host_igmp_is_member(&group)) {
+      return 0;
+    }
+  }
+  return host_udp_send(port, data, size, from);
+}
@@ -0,0 +1,295 @@
+// Tests of the addressable effect across frames: retransmitted frames keep the stream alive without being
+// converted or shown again, and interpolation settles on a look the console keeps sending.
+
+#include "esphome/core/hal.h"
+#include "host_support.h"
+#include "host_test.h"
+#include "sacn.h"
+#include "sacn_addressable_light_effect.h"
+#include "WiFiUdp.h"
+
+#include <cstring>
+#include <memory>
+
+using namespace esphome;
+using namespace esphome::sacn;
+using namespace esphome::sacn::testing;
+
+namespace {
+
+const uint16_t SACN_PORT = 5568;
+const int32_t LEDS = 200;  // 170 RGB pixels in the first universe, 30 in the second
+
+// A strip driven by one effect on universes 1 and 2
+struct Strip {
+  SACNComponent sacn;
+  HostAddressableLight light{LEDS};
+  light::LightState state{"Strip", &light};
+  SACNAddressableLightEffect effect{"sACN"};
+  uint8_t sequence{0};
+
+  explicit Strip(bool interpolation = false, SACNProtocol protocol = SACN_E131) {
+    this->effect.init_internal(&this->state);
+    this->effect.set_sacn(&this->sacn);
+    this->effect.set_universe(1);
+    this->effect.set_universe_count(protocol == SACN_E131 ? 2 : 1);
+    this->effect.set_timeout(100);
+    this->effect.set_fade_time(1000);
+    this->effect.set_interpolation(interpolation);
+    this->effect.set_protocol(protocol);
+    this->effect.start();
+  }
+  ~Strip() { this->effect.stop(); }
+
+  // Every channel of the universe at `level`, with the E1.31 option flags `flags`
+  void send(uint16_t universe, uint8_t level, uint8_t flags = 0) {
+    uint8_t levels[E131View::MAX_SLOTS];
+    memset(levels, level, sizeof(levels));
+    uint8_t packet[638];
+    E131PacketOptions options;
+    options.sequence = this->sequence++;
+    options.options = flags;
+    host_udp_send(SACN_PORT, packet, make_e131_packet(packet, universe, levels, E131View::MAX_SLOTS, options));
+  }
+
+  // The whole strip at `level`, in two DDP packets
+  void send_ddp(uint8_t level) {
+    uint8_t data[LEDS * 3];
+    memset(data, level, sizeof(data));
+    uint8_t packet[DDPView::MAX_PACKET_SIZE];
+    host_udp_send(DDPView::PORT, packet, make_ddp_packet(packet, 0, data, 300, false));
+    host_udp_send(DDPView::PORT, packet, make_ddp_packet(packet, 300, data + 300, sizeof(data) - 300, true));
+  }
+
+  // Every LED at `level`, as the light itself writes the Home Assistant color once the effect is released
+  void fill(uint8_t level) {
+    for (int32_t i = 0; i < LEDS; i++) {
+      this->light[i].set(Color(level, level, level, 0));
+    }
+  }
+
+  // After release the effect no longer writes or shows anything, leaving the Home Assistant color alone
+  bool leaves_strip_alone() {
+    this->fill(77);
+    uint32_t shows = this->shows();
+    for (int i = 0; i < 3; i++) {
+      host_advance_time(50);
+      this->update();
+    }
+    return this->shows() == shows && this->level(0) == 77 && this->level(LEDS - 1) == 77;
+  }
+
+  void update() {
+    this->sacn.loop();
+    this->effect.apply(this->light, Color::WHITE);
+  }
+
+  uint32_t shows() const { return this->light.get_show_count(); }
+  uint8_t level(int32_t led) const { return this->light.get_led(led).r; }
+};
+
+void test_retransmitted_frames() {
+  Strip strip;
+  strip.send(1, 10);
+  strip.send(2, 20);
+  strip.update();
+  SACN_CHECK(strip.level(0) == 10 && strip.level(LEDS - 1) == 20);
+  uint32_t shows = strip.shows();
+
+  // The console keeps sending the same look: nothing to show, but the stream stays alive past the timeout
+  for (int i = 0; i < 5; i++) {
+    host_advance_time(60);
+    strip.send(1, 10);
+    strip.send(2, 20);
+    strip.update();
+  }
+  SACN_CHECK(strip.shows() == shows);
+  SACN_CHECK(strip.level(0) == 10 && strip.level(LEDS - 1) == 20);
+
+  // An unchanged universe still completes the frame of a changed one
+  strip.send(1, 10);
+  strip.send(2, 21);
+  strip.update();
+  SACN_CHECK(strip.shows() == shows + 1);
+  SACN_CHECK(strip.level(0) == 10 && strip.level(LEDS - 1) == 21);
+
+  // Once fading, the same look resumes at full level
+  host_advance_time(300);
+  strip.update();
+  SACN_CHECK(strip.level(0) < 10);
+  strip.send(1, 10);
+  strip.send(2, 21);
+  strip.update();
+  SACN_CHECK(strip.level(0) == 10 && strip.level(LEDS - 1) == 21);
+}
+
+void test_retransmitted_ddp() {
+  Strip strip(false, SACN_DDP);
+  strip.send_ddp(30);
+  strip.update();
+  SACN_CHECK(strip.level(0) == 30 && strip.level(LEDS - 1) == 30);
+  uint32_t shows = strip.shows();
+
+  for (int i = 0; i < 5; i++) {
+    host_advance_time(60);
+    strip.send_ddp(30);
+    strip.update();
+  }
+  SACN_CHECK(strip.shows() == shows);
+  SACN_CHECK(strip.level(LEDS - 1) == 30);
+
+  strip.send_ddp(31);
+  strip.update();
+  SACN_CHECK(strip.shows() == shows + 1);
+  SACN_CHECK(strip.level(0) == 31 && strip.level(LEDS - 1) == 31);
+
+  host_advance_time(300);
+  strip.update();
+  SACN_CHECK(strip.level(0) < 31);
+  strip.send_ddp(31);
+  strip.update();
+  SACN_CHECK(strip.level(0) == 31);
+}
+
+// A blend runs on past the latest frame to conceal a lost one, but not past a frame confirmed by a retransmission
+void test_interpolation_settles() {
+  Strip strip(true);
+  const uint32_t INTERVAL = 20;
+  uint8_t level = 0;
+  for (int i = 0; i < 8; i++) {
+    level += 20;
+    strip.send(1, level);
+    strip.send(2, level);
+    strip.update();
+    host_advance_time(INTERVAL);
+  }
+  // The look stops changing at 160, blending up from 140
+  strip.send(1, level);
+  strip.send(2, level);
+  strip.update();
+  host_advance_time(INTERVAL);
+  strip.update();
+  SACN_CHECK(strip.level(0) == level);
+
+  // Half an interval later an unsettled blend would overshoot towards 180
+  host_advance_time(INTERVAL / 2);
+  strip.update();
+  SACN_CHECK(strip.level(0) == level);
+  uint32_t shows = strip.shows();
+  host_advance_time(INTERVAL);
+  strip.update();
+  SACN_CHECK(strip.shows() == shows);
+  SACN_CHECK(strip.level(0) == level && strip.level(LEDS - 1) == level);
+}
+
+// Without retransmissions, a lost frame is still concealed by carrying on the fade
+void test_interpolation_conceals_lost_frame() {
+  Strip strip(true);
+  const uint32_t INTERVAL = 20;
+  uint8_t level = 0;
+  for (int i = 0; i < 8; i++) {
+    level += 20;
+    strip.send(1, level);
+    strip.send(2, level);
+    strip.update();
+    host_advance_time(INTERVAL);
+  }
+  host_advance_time(INTERVAL / 2);
+  strip.update();
+  SACN_CHECK(strip.level(0) > level);
+}
+
+// A universe that loses its stream fades on its own LEDs, the effect is released once every universe is
+void test_universe_lost() {
+  Strip strip;
+  const int32_t SECOND_UNIVERSE = 170;
+  strip.send(1, 10);
+  strip.send(2, 200);
+  strip.update();
+  SACN_CHECK(strip.level(SECOND_UNIVERSE) == 200);
+
+  // Universe 2 stops; once it timed out, universe 1's frames show at once instead of waiting for the deadline
+  uint8_t level = 10;
+  for (int i = 0; i < 10; i++) {
+    host_advance_time(50);
+    strip.update();
+    uint32_t shows = strip.shows();
+    strip.send(1, ++level);
+    strip.update();
+    SACN_CHECK(i < 2 || strip.shows() > shows);
+    SACN_CHECK(strip.level(0) == level && strip.level(SECOND_UNIVERSE - 1) == level);
+  }
+  SACN_CHECK(strip.level(SECOND_UNIVERSE) < 200 && strip.level(LEDS - 1) < 200);
+  SACN_CHECK(strip.level(SECOND_UNIVERSE) > 0);
+
+  // Faded out and released, while the effect carries on with universe 1
+  for (int i = 0; i < 20; i++) {
+    host_advance_time(50);
+    strip.send(1, ++level);
+    strip.update();
+  }
+  SACN_CHECK(strip.level(SECOND_UNIVERSE) == 0 && strip.level(LEDS - 1) == 0);
+  SACN_CHECK(strip.level(0) == level);
+  SACN_CHECK(strip.light.is_effect_active());
+
+  // Universe 2 resumes at full level
+  strip.send(1, level);
+  strip.send(2, 200);
+  strip.update();
+  SACN_CHECK(strip.level(SECOND_UNIVERSE) == 200 && strip.level(0) == level);
+
+  // Both stop: released once the last one is
+  for (int i = 0; i < 30 && strip.light.is_effect_active(); i++) {
+    host_advance_time(50);
+    strip.update();
+  }
+  SACN_CHECK(!strip.light.is_effect_active());
+  SACN_CHECK(strip.leaves_strip_alone());
+}
+
+// A source terminating one universe fades just that universe's LEDs straight away
+void test_universe_terminated() {
+  Strip strip;
+  const int32_t SECOND_UNIVERSE = 170;
+  strip.send(1, 10);
+  strip.send(2, 200);
+  strip.update();
+
+  // Well within the timeout, universe 2 is already fading
+  strip.send(2, 200, E131View::OPTION_STREAM_TERMINATED);
+  strip.update();
+  host_advance_time(50);
+  strip.update();
+  SACN_CHECK(strip.level(SECOND_UNIVERSE) < 200 && strip.level(SECOND_UNIVERSE) > 0);
+  SACN_CHECK(strip.level(0) == 10);
+  strip.send(1, 11);
+  strip.update();
+  SACN_CHECK(strip.level(0) == 11);
+
+  // Universe 1 terminated too: the effect is released once universe 2 has faded out as well
+  strip.send(1, 11, E131View::OPTION_STREAM_TERMINATED);
+  strip.update();
+  host_advance_time(100);
+  strip.update();
+  SACN_CHECK(strip.level(0) < 11);
+  host_advance_time(400);
+  strip.update();
+  SACN_CHECK(strip.light.is_effect_active());
+  host_advance_time(600);
+  strip.update();
+  SACN_CHECK(!strip.light.is_effect_active());
+  SACN_CHECK(strip.leaves_strip_alone());
+}
+
+}  // namespace
+
+int main() {
+  test_retransmitted_frames();
+  test_retransmitted_ddp();
+  test_interpolation_settles();
+  test_interpolation_conceals_lost_frame();
+  test_universe_lost();
+  test_universe_terminated();
+
+  return test_result();
+}
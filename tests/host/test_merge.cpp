@@ -0,0 +1,155 @@
+// Tests of per-address priority merging: the four-lane kernel against the one merging byte by byte, and late
+// per-address priority packets being dropped like late data.
+//
+//   test_merge [iterations] [seed]
+
+#include "host_support.h"
+#include "host_test.h"
+#include "sacn.h"
+#include "sacn_merge.h"
+#include "WiFiUdp.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+using namespace esphome;
+using namespace esphome::sacn;
+using namespace esphome::sacn::testing;
+
+namespace {
+
+std::mt19937 rng;
+
+uint8_t random_byte() { return std::uniform_int_distribution<uint32_t>(0, 255)(rng); }
+
+// Merges the sources with both kernels, at the given offset into the buffers so every alignment is covered, and
+// compares the results
+void check_kernels(const uint8_t *levels, const uint8_t *priorities, uint8_t sources, size_t size, size_t offset) {
+  const size_t MAX = 600;
+  uint8_t expected_levels[MAX] = {}, expected_priorities[MAX] = {};
+  uint8_t merged_levels[MAX] = {}, merged_priorities[MAX] = {};
+  for (uint8_t s = 0; s < sources; s++) {
+    sacn_merge_priority_bytes(expected_levels + offset, expected_priorities + offset, levels + s * MAX,
+                              priorities + s * MAX, size);
+    sacn_merge_priority(merged_levels + offset, merged_priorities + offset, levels + s * MAX, priorities + s * MAX,
+                        size);
+  }
+  // The bytes around the merged range are untouched as well
+  SACN_CHECK(memcmp(merged_levels, expected_levels, MAX) == 0);
+  SACN_CHECK(memcmp(merged_priorities, expected_priorities, MAX) == 0);
+}
+
+// Every pair of priorities against every pair of levels, in steps that include the lane boundaries 0x7F/0x80
+void test_kernel_pairs() {
+  static const uint8_t VALUES[] = {0, 1, 2, 0x3F, 0x40, 0x7E, 0x7F, 0x80, 0x81, 0xC0, 0xFE, 0xFF};
+  const size_t N = sizeof(VALUES);
+  for (uint8_t priority_a : VALUES) {
+    for (uint8_t priority_b : VALUES) {
+      // Two sources, each address holding one combination of levels
+      uint8_t levels[2 * 600] = {}, priorities[2 * 600] = {};
+      for (size_t i = 0; i < N * N; i++) {
+        levels[i] = VALUES[i / N];
+        levels[600 + i] = VALUES[i % N];
+        priorities[i] = priority_a;
+        priorities[600 + i] = priority_b;
+      }
+      check_kernels(levels, priorities, 2, N * N, 0);
+    }
+  }
+
+  // Every byte against every byte, once as levels and once as priorities
+  uint8_t levels[2 * 600], priorities[2 * 600];
+  for (uint16_t a = 0; a < 256; a++) {
+    for (uint16_t b = 0; b < 256; b += 2) {
+      for (uint16_t i = 0; i < 2; i++) {
+        levels[i] = a;
+        levels[600 + i] = b + i;
+        priorities[i] = 100;
+        priorities[600 + i] = 100;
+        levels[2 + i] = 1;
+        levels[602 + i] = 2;
+        priorities[2 + i] = a;
+        priorities[602 + i] = b + i;
+      }
+      check_kernels(levels, priorities, 2, 4, a % 4);
+    }
+  }
+}
+
+void fuzz_kernels(uint32_t iterations) {
+  uint8_t levels[4 * 600], priorities[4 * 600];
+  for (uint32_t n = 0; n < iterations; n++) {
+    // Few distinct priorities, so ties are common
+    for (size_t i = 0; i < sizeof(levels); i++) {
+      levels[i] = random_byte();
+      priorities[i] = random_byte() % 4 * 0x55;
+    }
+    uint8_t sources = 1 + random_byte() % 4;
+    size_t size = std::uniform_int_distribution<size_t>(0, 512)(rng);
+    check_kernels(levels, priorities, sources, size, random_byte() % 8);
+  }
+}
+
+// A late per-address priority packet must not replace the priorities that arrived after it
+void test_late_priorities() {
+  const uint16_t SACN_PORT = 5568;
+  SACNComponent sacn;
+  CountingEffect effect("Effect");
+  effect.set_sacn(&sacn);
+  effect.start();
+
+  uint8_t packet[638];
+  uint8_t values[E131View::MAX_SLOTS];
+  auto send = [&](uint8_t source, uint8_t sequence, uint8_t start_code, uint8_t value) {
+    memset(values, value, sizeof(values));
+    E131PacketOptions options;
+    options.source = source;
+    options.sequence = sequence;
+    options.start_code = start_code;
+    host_udp_send(SACN_PORT, packet, make_e131_packet(packet, 1, values, E131View::MAX_SLOTS, options));
+  };
+
+  // Both sources at the same universe priority, the first one taking every address by per-address priority
+  send(1, 1, E131View::START_CODE_DMX, 10);
+  send(2, 1, E131View::START_CODE_DMX, 20);
+  send(1, 2, E131View::START_CODE_ADDRESS_PRIORITY, 200);
+  send(2, 2, E131View::START_CODE_ADDRESS_PRIORITY, 50);
+  // Levels are kept for merging from here on, the merge starts once both sources sent theirs
+  send(2, 3, E131View::START_CODE_DMX, 20);
+  send(1, 3, E131View::START_CODE_DMX, 10);
+  sacn.loop();
+  effect.apply();
+  SACN_CHECK(effect.first_level == 10);
+
+  // Sequence 1 is behind 3: dropped, the first source keeps priority 200 rather than releasing every address
+  uint32_t out_of_order = sacn.get_universes()[0].stats.out_of_order;
+  send(1, 1, E131View::START_CODE_ADDRESS_PRIORITY, 0);
+  send(1, 4, E131View::START_CODE_DMX, 11);
+  sacn.loop();
+  effect.apply();
+  SACN_CHECK(sacn.get_universes()[0].stats.out_of_order == out_of_order + 1);
+  SACN_CHECK(effect.first_level == 11);
+
+  // In sequence, the same packet does release them
+  send(1, 5, E131View::START_CODE_ADDRESS_PRIORITY, 0);
+  send(1, 6, E131View::START_CODE_DMX, 12);
+  sacn.loop();
+  effect.apply();
+  SACN_CHECK(effect.first_level == 20);
+
+  effect.stop();
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  uint32_t iterations = argc > 1 ? strtoul(argv[1], nullptr, 0) : 2000;
+  rng.seed(argc > 2 ? strtoul(argv[2], nullptr, 0) : 1);
+
+  test_kernel_pairs();
+  fuzz_kernels(iterations);
+  test_late_priorities();
+
+  return test_result();
+}
@@ -0,0 +1,233 @@
+// Tests of multicast group membership: effects join the group of each of their universes, effects sharing a
+// universe share its membership, and a group is left once the last effect using it stopped. Failed joins are
+// retried, and every group is joined again after the network reconnects.
+
+#include "esphome/components/network/util.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+#include "host_support.h"
+#include "host_test.h"
+#include "lwip/igmp.h"
+#include "sacn.h"
+#include "WiFiUdp.h"
+
+using namespace esphome;
+using namespace esphome::sacn;
+using namespace esphome::sacn::testing;
+
+namespace {
+
+const uint16_t SACN_PORT = 5568;
+
+bool is_member(uint16_t universe) {
+  ip4_addr_t group;
+  IP4_ADDR(&group, 239, 255, universe >> 8, universe & 0xFF);
+  return host_igmp_is_member(&group);
+}
+
+// Sends one frame of `universe` to its multicast group, then lets the component and `effect` receive it.
+// Returns whether the effect got the frame.
+bool receive_multicast(SACNComponent &sacn, CountingEffect &effect, uint16_t universe) {
+  static uint8_t sequence = 0;
+  uint8_t levels[E131View::MAX_SLOTS] = {};
+  uint8_t packet[638];
+  E131PacketOptions options;
+  options.sequence = sequence++;
+  uint16_t size = make_e131_packet(packet, universe, levels, E131View::MAX_SLOTS, options);
+  host_udp_send_to(IPAddress(239, 255, universe >> 8, universe & 0xFF), SACN_PORT, packet, size);
+
+  uint32_t frames = effect.frames;
+  sacn.loop();
+  effect.apply();
+  return effect.frames > frames;
+}
+
+void configure(CountingEffect &effect, SACNComponent &sacn, uint16_t universe, uint8_t count,
+               SACNTransportMode mode) {
+  effect.set_sacn(&sacn);
+  effect.set_universe(universe);
+  effect.set_universe_count(count);
+  effect.set_transport_mode(mode);
+}
+
+void test_shared_membership() {
+  SACNComponent sacn;
+  CountingEffect first("First");
+  configure(first, sacn, 1, 3, SACN_MULTICAST);
+  CountingEffect second("Second");
+  configure(second, sacn, 2, 3, SACN_MULTICAST);
+  CountingEffect unicast("Unicast");
+  configure(unicast, sacn, 10, 1, SACN_UNICAST);
+
+  first.start();
+  SACN_CHECK(is_member(1) && is_member(2) && is_member(3));
+  SACN_CHECK(host_igmp_group_count() == 3);
+
+  // Universes 2 and 3 are joined already, only 4 is new
+  uint32_t requests = host_igmp_requests();
+  second.start();
+  SACN_CHECK(host_igmp_requests() == requests + 1);
+  SACN_CHECK(is_member(4));
+  SACN_CHECK(host_igmp_group_count() == 4);
+
+  unicast.start();
+  SACN_CHECK(!is_member(10));
+  SACN_CHECK(host_igmp_group_count() == 4);
+
+  SACN_CHECK(receive_multicast(sacn, first, 1));
+  SACN_CHECK(receive_multicast(sacn, second, 4));
+  SACN_CHECK(!receive_multicast(sacn, unicast, 10));
+
+  // The shared universes stay joined for the second effect
+  first.stop();
+  SACN_CHECK(!is_member(1));
+  SACN_CHECK(is_member(2) && is_member(3) && is_member(4));
+  SACN_CHECK(receive_multicast(sacn, second, 2));
+
+  second.stop();
+  SACN_CHECK(host_igmp_group_count() == 0);
+  unicast.stop();
+}
+
+void test_group_address() {
+  SACNComponent sacn;
+  CountingEffect effect("Effect");
+  configure(effect, sacn, 0x1234, 1, SACN_MULTICAST);
+  effect.start();
+
+  ip4_addr_t group;
+  IP4_ADDR(&group, 239, 255, 0x12, 0x34);
+  SACN_CHECK(host_igmp_is_member(&group));
+  SACN_CHECK(receive_multicast(sacn, effect, 0x1234));
+
+  effect.stop();
+  SACN_CHECK(!host_igmp_is_member(&group));
+}
+
+// Restarting an effect, as when switching between effects, leaves and joins its groups again
+void test_restart() {
+  SACNComponent sacn;
+  CountingEffect effect("Effect");
+  configure(effect, sacn, 7, 2, SACN_MULTICAST);
+  for (int i = 0; i < 3; i++) {
+    effect.start();
+    SACN_CHECK(is_member(7) && is_member(8));
+    SACN_CHECK(receive_multicast(sacn, effect, 8));
+    effect.stop();
+    SACN_CHECK(host_igmp_group_count() == 0);
+  }
+}
+
+// The membership counts from the first effect on a universe, whether lwIP accepted its join or not. A failed
+// join is not repeated for the other effects, and not left, as there is nothing to leave.
+void test_failed_join() {
+  SACNComponent sacn;
+  CountingEffect first("First");
+  configure(first, sacn, 20, 1, SACN_MULTICAST);
+  CountingEffect second("Second");
+  configure(second, sacn, 20, 1, SACN_MULTICAST);
+
+  host_igmp_set_full(true);
+  first.start();
+  host_igmp_set_full(false);
+  SACN_CHECK(!is_member(20));
+
+  uint32_t requests = host_igmp_requests();
+  second.start();
+  SACN_CHECK(host_igmp_requests() == requests);
+  second.stop();
+  SACN_CHECK(host_igmp_requests() == requests);
+  first.stop();
+  SACN_CHECK(host_igmp_requests() == requests);
+
+  // Nothing is left over, and the next start joins normally
+  first.start();
+  SACN_CHECK(is_member(20));
+  first.stop();
+  SACN_CHECK(host_igmp_group_count() == 0);
+}
+
+// A failed join is retried from loop() until lwIP accepts it
+void test_join_retry() {
+  SACNComponent sacn;
+  CountingEffect effect("Effect");
+  configure(effect, sacn, 30, 1, SACN_MULTICAST);
+
+  host_igmp_set_full(true);
+  effect.start();
+  host_advance_time(1000);
+  sacn.loop();
+  SACN_CHECK(!is_member(30));
+
+  host_igmp_set_full(false);
+  host_advance_time(1000);
+  sacn.loop();
+  SACN_CHECK(is_member(30));
+  SACN_CHECK(receive_multicast(sacn, effect, 30));
+
+  // Joined once: a single leave drops the group
+  effect.stop();
+  SACN_CHECK(host_igmp_group_count() == 0);
+}
+
+// Effects starting before WiFi is up, as at boot, join once it connects
+void test_join_before_network() {
+  SACNComponent sacn;
+  CountingEffect effect("Effect");
+  configure(effect, sacn, 40, 2, SACN_MULTICAST);
+
+  host_set_network_connected(false);
+  sacn.loop();
+  effect.start();
+  SACN_CHECK(host_igmp_group_count() == 0);
+  host_advance_time(1000);
+  sacn.loop();
+  SACN_CHECK(host_igmp_group_count() == 0);
+
+  host_set_network_connected(true);
+  sacn.loop();
+  SACN_CHECK(is_member(40) && is_member(41));
+  SACN_CHECK(receive_multicast(sacn, effect, 41));
+
+  effect.stop();
+  SACN_CHECK(host_igmp_group_count() == 0);
+}
+
+// The interface drops its memberships when WiFi disconnects, they are joined again on reconnect
+void test_reconnect() {
+  SACNComponent sacn;
+  CountingEffect effect("Effect");
+  configure(effect, sacn, 50, 2, SACN_MULTICAST);
+  effect.start();
+  SACN_CHECK(receive_multicast(sacn, effect, 50));
+
+  host_set_network_connected(false);
+  sacn.loop();
+  SACN_CHECK(host_igmp_group_count() == 0);
+  host_advance_time(1000);
+  host_set_network_connected(true);
+  SACN_CHECK(!receive_multicast(sacn, effect, 50));  // Joined again by this loop(), after the packet was sent
+  SACN_CHECK(is_member(50) && is_member(51));
+  SACN_CHECK(receive_multicast(sacn, effect, 50));
+  SACN_CHECK(receive_multicast(sacn, effect, 51));
+
+  effect.stop();
+  SACN_CHECK(host_igmp_group_count() == 0);
+}
+
+}  // namespace
+
+int main() {
+  // The failed joins are logged as warnings, expected here
+  host_set_log_level(ESPHOME_LOG_LEVEL_ERROR);
+
+  test_shared_membership();
+  test_group_address();
+  test_restart();
+  test_failed_join();
+  test_join_retry();
+  test_join_before_network();
+  test_reconnect();
+
+  return test_result();
+}
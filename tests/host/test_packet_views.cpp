@@ -0,0 +1,422 @@
+// Property and fuzz tests of E131View and DDPView: well-formed packets parse to what was sent, and malformed,
+// truncated or oversized ones are either rejected or only ever read within the received bytes. Ranges of a universe
+// are also written into an SACNFrame, which must not expose channels no packet carried.
+//
+// Every packet is parsed from a heap copy of exactly its size, so with the sanitizers (SACN_HOST_SANITIZE) any
+// read past the end fails the test as well.
+//
+//   test_packet_views [iterations] [seed]
+
+#include "host_support.h"
+#include "host_test.h"
+#include "sacn.h"
+#include "sacn_ddp.h"
+#include "sacn_e131.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace esphome::sacn;
+using namespace esphome::sacn::testing;
+
+namespace {
+
+std::mt19937 rng;
+
+uint32_t random_below(uint32_t limit) { return std::uniform_int_distribution<uint32_t>(0, limit - 1)(rng); }
+
+// Touches every field a valid view exposes and checks each stays within [data, data + size)
+uint32_t read_e131(const E131View &view, const uint8_t *data, size_t size) {
+  const uint8_t *end = data + size;
+  uint32_t sum = view.sequence() + view.sync_address();
+  SACN_CHECK(view.cid() >= data && view.cid() + 16 <= end);
+  if (view.is_sync()) {
+    SACN_CHECK(size >= E131View::SYNC_PACKET_SIZE);
+    return sum;
+  }
+
+  SACN_CHECK(size >= E131View::HEADER_SIZE - 1);
+  SACN_CHECK(reinterpret_cast<const uint8_t *>(view.source_name()) + 64 <= end);
+  sum += view.priority() + view.options() + view.universe() + view.start_code();
+
+  uint16_t first = view.first_channel();
+  uint16_t count = view.dmx_size();
+  SACN_CHECK(first >= 1);
+  SACN_CHECK(count <= E131View::MAX_SLOTS);
+  SACN_CHECK(count == 0 || first + count - 1 <= E131View::MAX_SLOTS);
+  SACN_CHECK(view.dmx() >= data + E131View::HEADER_SIZE - 1);
+  if (SACN_CHECK(view.dmx() + count <= end)) {
+    for (uint16_t i = 0; i < count; i++) {
+      sum += view.dmx()[i];
+    }
+  }
+  return sum;
+}
+
+uint32_t read_ddp(const DDPView &view, const uint8_t *data, size_t size) {
+  const uint8_t *end = data + size;
+  uint32_t sum = view.is_push() + view.sequence() + view.data_type() + view.destination() + view.offset();
+  SACN_CHECK(view.data_size() <= DDPView::MAX_DATA_SIZE);
+  SACN_CHECK(view.data() >= data + DDPView::HEADER_SIZE);
+  if (SACN_CHECK(view.data() + view.data_size() <= end)) {
+    for (uint16_t i = 0; i < view.data_size(); i++) {
+      sum += view.data()[i];
+    }
+  }
+  return sum;
+}
+
+// Parses `size` bytes of `packet` from an allocation of exactly that size
+E131View parse_e131_exact(const uint8_t *packet, size_t size, std::vector<uint8_t> &copy) {
+  copy.assign(packet, packet + size);
+  return E131View::parse(copy.data(), size);
+}
+
+void test_e131_round_trip() {
+  uint8_t levels[E131View::MAX_SLOTS];
+  uint8_t packet[638];
+  std::vector<uint8_t> copy;
+  for (uint16_t count : {1, 2, 3, 170, 511, 512}) {
+    for (uint16_t i = 0; i < count; i++) {
+      levels[i] = i * 31 + count;
+    }
+    E131PacketOptions options;
+    options.sequence = count;
+    options.priority = 150;
+    options.sync_address = 7;
+    options.options = E131View::OPTION_PREVIEW_DATA;
+    uint16_t size = make_e131_packet(packet, 63999, levels, count, options);
+
+    E131View view = parse_e131_exact(packet, size, copy);
+    if (!SACN_CHECK(view.is_data())) {
+      continue;
+    }
+    SACN_CHECK(view.universe() == 63999);
+    SACN_CHECK(view.priority() == 150);
+    SACN_CHECK(view.sequence() == (uint8_t) count);
+    SACN_CHECK(view.sync_address() == 7);
+    SACN_CHECK(view.is_preview());
+    SACN_CHECK(!view.is_terminated());
+    SACN_CHECK(view.start_code() == E131View::START_CODE_DMX);
+    SACN_CHECK(view.first_channel() == 1);
+    SACN_CHECK(view.dmx_size() == count);
+    SACN_CHECK(memcmp(view.dmx(), levels, count) == 0);
+    read_e131(view, copy.data(), size);
+  }
+
+  // Zero slots: a start code alone is valid and carries no levels
+  uint16_t size = make_e131_packet(packet, 1, levels, 0);
+  E131View view = parse_e131_exact(packet, size, copy);
+  SACN_CHECK(view.is_data() && view.dmx_size() == 0);
+
+  // Per-address priority start code
+  E131PacketOptions options;
+  options.start_code = E131View::START_CODE_ADDRESS_PRIORITY;
+  size = make_e131_packet(packet, 1, levels, 512, options);
+  view = parse_e131_exact(packet, size, copy);
+  SACN_CHECK(view.is_data() && view.start_code() == E131View::START_CODE_ADDRESS_PRIORITY);
+
+  // Sync packets
+  size = make_e131_sync_packet(packet, 1234, 99);
+  view = parse_e131_exact(packet, size, copy);
+  SACN_CHECK(view.is_sync());
+  SACN_CHECK(view.sync_address() == 1234);
+  SACN_CHECK(view.sequence() == 99);
+}
+
+// Ranges of a universe start at any channel; whatever reaches past channel 512 is dropped
+void test_e131_ranges() {
+  uint8_t levels[E131View::MAX_SLOTS];
+  memset(levels, 0x5A, sizeof(levels));
+  uint8_t packet[638];
+  std::vector<uint8_t> copy;
+  for (uint16_t first : {1, 2, 100, 500, 511, 512, 513, 600, 65535}) {
+    for (uint16_t count : {1, 13, 100, 512}) {
+      E131PacketOptions options;
+      options.first_address = first;
+      uint16_t size = make_e131_packet(packet, 1, levels, count, options);
+      E131View view = parse_e131_exact(packet, size, copy);
+      if (!SACN_CHECK(view.is_data())) {
+        continue;
+      }
+      SACN_CHECK(view.first_channel() == first);
+      uint16_t expected = first > 512 ? 0 : std::min<uint16_t>(count, 513 - first);
+      SACN_CHECK(view.dmx_size() == expected);
+      read_e131(view, copy.data(), size);
+    }
+  }
+}
+
+// A range written into a frame leaves the channels below it off, whatever the buffer held before
+void test_e131_range_frames() {
+  uint8_t levels[E131View::MAX_SLOTS];
+  memset(levels, 0x5A, sizeof(levels));
+  uint8_t packet[638];
+  std::vector<uint8_t> copy;
+  auto frame = std::unique_ptr<SACNFrame>(new SACNFrame());
+  memset(frame->data, 0xEE, sizeof(frame->data));
+
+  // A fresh universe
+  E131PacketOptions options;
+  options.first_address = 100;
+  frame->write(parse_e131_exact(packet, make_e131_packet(packet, 1, levels, 13, options), copy));
+  SACN_CHECK(frame->size == 112);
+  SACN_CHECK(std::all_of(frame->data, frame->data + 99, [](uint8_t level) { return level == 0; }));
+  SACN_CHECK(std::all_of(frame->data + 99, frame->data + 112, [](uint8_t level) { return level == 0x5A; }));
+
+  // Past the end of a shorter full universe, over channels the earlier range left behind
+  frame->write(parse_e131_exact(packet, make_e131_packet(packet, 1, levels, 50), copy));
+  options.first_address = 200;
+  frame->write(parse_e131_exact(packet, make_e131_packet(packet, 1, levels, 13, options), copy));
+  SACN_CHECK(frame->size == 212);
+  SACN_CHECK(std::all_of(frame->data, frame->data + 50, [](uint8_t level) { return level == 0x5A; }));
+  SACN_CHECK(std::all_of(frame->data + 50, frame->data + 199, [](uint8_t level) { return level == 0; }));
+  SACN_CHECK(std::all_of(frame->data + 199, frame->data + 212, [](uint8_t level) { return level == 0x5A; }));
+}
+
+// Every prefix of a valid packet is rejected, except for those the length fields still fit
+void test_e131_truncated() {
+  uint8_t levels[E131View::MAX_SLOTS] = {};
+  uint8_t packet[638];
+  std::vector<uint8_t> copy;
+
+  uint16_t size = make_e131_packet(packet, 1, levels, 512);
+  for (uint16_t length = 0; length < size; length++) {
+    E131View view = parse_e131_exact(packet, length, copy);
+    // The PDU lengths still count the missing bytes
+    SACN_CHECK(!view.is_data() && !view.is_sync());
+  }
+
+  size = make_e131_sync_packet(packet, 1, 0);
+  for (uint16_t length = 0; length < size; length++) {
+    SACN_CHECK(!parse_e131_exact(packet, length, copy).is_sync());
+  }
+}
+
+// Length fields that disagree with the received size
+void test_e131_lengths() {
+  uint8_t levels[E131View::MAX_SLOTS] = {};
+  uint8_t packet[700];
+  std::vector<uint8_t> copy;
+  uint16_t size = make_e131_packet(packet, 1, levels, 100);
+
+  // Trailing bytes past the PDUs, as from padding, are ignored
+  memset(packet + size, 0xEE, sizeof(packet) - size);
+  E131View view = parse_e131_exact(packet, sizeof(packet), copy);
+  SACN_CHECK(view.is_data() && view.dmx_size() == 100);
+
+  // A property value count reaching past the packet
+  packet[123] = 0x01;
+  packet[124] = 0x00;
+  SACN_CHECK(!parse_e131_exact(packet, size, copy).is_data());
+
+  // More than a start code and 512 slots
+  size = make_e131_packet(packet, 1, levels, 512);
+  packet[123] = 0x02;
+  packet[124] = 0x02;
+  SACN_CHECK(!parse_e131_exact(packet, sizeof(packet), copy).is_data());
+
+  // No property values at all
+  size = make_e131_packet(packet, 1, levels, 10);
+  packet[123] = 0;
+  packet[124] = 0;
+  SACN_CHECK(!parse_e131_exact(packet, size, copy).is_data());
+
+  // Each PDU length reaching past the packet
+  for (uint16_t offset : {16, 38, 115}) {
+    size = make_e131_packet(packet, 1, levels, 10);
+    packet[offset] = 0x7F;
+    packet[offset + 1] = 0xFF;
+    SACN_CHECK(!parse_e131_exact(packet, size, copy).is_data());
+  }
+
+  // Unknown vectors
+  for (uint16_t offset : {21, 43, 117, 118}) {
+    size = make_e131_packet(packet, 1, levels, 10);
+    packet[offset] ^= 0x10;
+    SACN_CHECK(!parse_e131_exact(packet, size, copy).is_data());
+  }
+}
+
+// Valid packets of every kind, then random damage: byte flips, field overwrites and a random length
+void fuzz_e131(uint32_t iterations) {
+  uint8_t levels[E131View::MAX_SLOTS];
+  uint8_t packet[1024];
+  std::vector<uint8_t> copy;
+  uint32_t accepted = 0;
+  volatile uint32_t sink = 0;
+
+  for (uint32_t n = 0; n < iterations; n++) {
+    for (auto &level : levels) {
+      level = random_below(256);
+    }
+    uint16_t size;
+    if (random_below(8) == 0) {
+      size = make_e131_sync_packet(packet, random_below(65536), random_below(256));
+    } else {
+      E131PacketOptions options;
+      options.first_address = random_below(4) == 0 ? random_below(600) : 0;
+      options.start_code = random_below(2) == 0 ? 0 : random_below(256);
+      size = make_e131_packet(packet, random_below(65536), levels, random_below(513), options);
+    }
+    for (uint16_t i = size; i < sizeof(packet); i++) {
+      packet[i] = random_below(256);
+    }
+
+    switch (random_below(4)) {
+      case 0:
+        // Flip bits in a few random bytes
+        for (uint32_t i = random_below(4) + 1; i > 0; i--) {
+          packet[random_below(size)] ^= 1 << random_below(8);
+        }
+        break;
+      case 1: {
+        // Overwrite a length, count or address field
+        static const uint16_t FIELDS[] = {16, 38, 115, 119, 123};
+        uint16_t field = FIELDS[random_below(5)];
+        packet[field] = random_below(256);
+        packet[field + 1] = random_below(256);
+        break;
+      }
+      case 2:
+        // Truncate
+        size = random_below(size + 1);
+        break;
+      default:
+        // Random length, garbage past the packet included
+        size = random_below(sizeof(packet) + 1);
+        break;
+    }
+
+    E131View view = parse_e131_exact(packet, size, copy);
+    if (view.is_data() || view.is_sync()) {
+      accepted++;
+      sink = sink + read_e131(view, copy.data(), size);
+    }
+  }
+  // The damage leaves a good share of the packets valid, so the accepting side gets fuzzed too
+  SACN_CHECK(accepted > iterations / 8);
+}
+
+DDPView parse_ddp_exact(const uint8_t *packet, size_t size, std::vector<uint8_t> &copy) {
+  copy.assign(packet, packet + size);
+  return DDPView::parse(copy.data(), size);
+}
+
+void test_ddp() {
+  uint8_t data[DDPView::MAX_DATA_SIZE];
+  for (uint16_t i = 0; i < sizeof(data); i++) {
+    data[i] = i * 7;
+  }
+  uint8_t packet[DDPView::MAX_PACKET_SIZE + 16];
+  std::vector<uint8_t> copy;
+
+  for (uint16_t count : {0, 1, 3, 480, 1440}) {
+    uint16_t size = make_ddp_packet(packet, 123456, data, count, true, 5);
+    DDPView view = parse_ddp_exact(packet, size, copy);
+    if (!SACN_CHECK(view.is_valid())) {
+      continue;
+    }
+    SACN_CHECK(view.is_push());
+    SACN_CHECK(view.sequence() == 5);
+    SACN_CHECK(view.is_display());
+    SACN_CHECK(view.offset() == 123456);
+    SACN_CHECK(view.data_size() == count);
+    SACN_CHECK(memcmp(view.data(), data, count) == 0);
+    read_ddp(view, copy.data(), size);
+
+    // Every prefix missing data is rejected
+    for (uint16_t length = 0; length < size; length++) {
+      SACN_CHECK(!parse_ddp_exact(packet, length, copy).is_valid());
+    }
+  }
+
+  // The timecode follows the header and comes before the data
+  uint16_t size = make_ddp_packet(packet, 0, data, 100, false);
+  memmove(packet + DDPView::HEADER_SIZE + DDPView::TIMECODE_SIZE, packet + DDPView::HEADER_SIZE, 100);
+  packet[0] |= DDPView::FLAG_TIMECODE;
+  DDPView view = parse_ddp_exact(packet, size + DDPView::TIMECODE_SIZE, copy);
+  SACN_CHECK(view.is_valid() && view.data_size() == 100 && memcmp(view.data(), data, 100) == 0);
+  SACN_CHECK(!parse_ddp_exact(packet, size, copy).is_valid());
+
+  // More data than a DDP packet carries, even when received
+  size = make_ddp_packet(packet, 0, data, DDPView::MAX_DATA_SIZE, true);
+  packet[8] = (DDPView::MAX_DATA_SIZE + 3) >> 8;
+  packet[9] = (DDPView::MAX_DATA_SIZE + 3) & 0xFF;
+  SACN_CHECK(!parse_ddp_exact(packet, size + 3, copy).is_valid());
+
+  // Configuration packets and other versions
+  for (uint8_t flags : {DDPView::FLAG_QUERY, DDPView::FLAG_REPLY, DDPView::FLAG_STORAGE}) {
+    size = make_ddp_packet(packet, 0, data, 10, true);
+    packet[0] |= flags;
+    SACN_CHECK(!parse_ddp_exact(packet, size, copy).is_valid());
+  }
+  size = make_ddp_packet(packet, 0, data, 10, true);
+  packet[0] = (packet[0] & ~DDPView::VERSION_MASK) | 0x80;
+  SACN_CHECK(!parse_ddp_exact(packet, size, copy).is_valid());
+}
+
+void fuzz_ddp(uint32_t iterations) {
+  uint8_t data[DDPView::MAX_DATA_SIZE];
+  uint8_t packet[DDPView::MAX_PACKET_SIZE + 64];
+  std::vector<uint8_t> copy;
+  uint32_t accepted = 0;
+  volatile uint32_t sink = 0;
+
+  for (uint32_t n = 0; n < iterations; n++) {
+    for (uint16_t i = 0; i < sizeof(data); i++) {
+      data[i] = random_below(256);
+    }
+    uint16_t size = make_ddp_packet(packet, random_below(0xFFFFFFFF), data, random_below(DDPView::MAX_DATA_SIZE + 1),
+                                    random_below(2));
+    for (uint16_t i = size; i < sizeof(packet); i++) {
+      packet[i] = random_below(256);
+    }
+
+    switch (random_below(4)) {
+      case 0:
+        packet[0] ^= 1 << random_below(8);
+        break;
+      case 1:
+        packet[8] = random_below(256);
+        packet[9] = random_below(256);
+        break;
+      case 2:
+        size = random_below(size + 1);
+        break;
+      default:
+        size = random_below(sizeof(packet) + 1);
+        break;
+    }
+
+    DDPView view = parse_ddp_exact(packet, size, copy);
+    if (view.is_valid()) {
+      accepted++;
+      sink = sink + read_ddp(view, copy.data(), size);
+    }
+  }
+  SACN_CHECK(accepted > iterations / 8);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  uint32_t iterations = argc > 1 ? strtoul(argv[1], nullptr, 0) : 20000;
+  uint32_t seed = argc > 2 ? strtoul(argv[2], nullptr, 0) : 1;
+  rng.seed(seed);
+
+  test_e131_round_trip();
+  test_e131_ranges();
+  test_e131_range_frames();
+  test_e131_truncated();
+  test_e131_lengths();
+  fuzz_e131(iterations);
+  test_ddp();
+  fuzz_ddp(iterations);
+
+  return test_result();
+}